@@ -28,7 +28,8 @@
 #pragma once
 
 #include <cstdint> // for ssize_t on android
-#include <string>  // for ssize_t on linux
+#include <memory>
+#include <string> // for ssize_t on linux
 #include "base/Macros.h"
 
 /**
@@ -107,6 +108,22 @@ public:
      */
     void fastSet(unsigned char *bytes, ssize_t size);
 
+    /** Sets the data to a view of an external buffer without copying it.
+     *  @param bytes The buffer pointer, it will never be freed by Data.
+     *  @param owner The object which keeps `bytes` alive, it's released when the data is cleared.
+     *  @note Methods which need to own the buffer, such as `resize` and `takeBuffer`,
+     *        copy the viewed bytes into a malloc'd buffer first.
+     *  @see Data::isView
+     */
+    void setView(unsigned char *bytes, ssize_t size, std::shared_ptr<void> owner);
+
+    /**
+     * Check whether the data is a view of an external buffer set by `setView`.
+     *
+     * @return True if the bytes are borrowed from an owner, false if they're owned by Data.
+     */
+    bool isView() const;
+
     void resize(ssize_t size);
 
     /**
@@ -145,10 +162,12 @@ public:
 
 private:
     void move(Data &other); //NOLINT
+    void detachView();
 
 private:
-    unsigned char *_bytes;
-    ssize_t        _size;
+    unsigned char *       _bytes;
+    ssize_t               _size;
+    std::shared_ptr<void> _owner;
 };
 
 } // namespace cc
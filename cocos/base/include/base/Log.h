@@ -55,6 +55,24 @@ public:
     static void            close();
     static void            logMessage(LogType type, LogLevel level, const char *formats, ...);
 
+    /**
+     * @brief Enables writing logs in a background thread.
+     * @param enabled Whether to write logs asynchronously, pending logs are written before it returns if it's disabled.
+     * @param capacity The max count of pending log records, it's rounded up to a power of two. Logs are dropped and counted if it's exceeded.
+     *        Every record reserves 4 KB, the size of a formatted message.
+     * @note FATAL logs are always written synchronously.
+     */
+    static void     setAsyncMode(bool enabled, uint32_t capacity = 1024);
+    static bool     isAsyncMode();
+    /**
+     * @brief Blocks until all pending logs are written in async mode.
+     */
+    static void     flush();
+    static uint64_t getDroppedCount();
+
+    // Private API used by the async writer
+    static void _writeRecord(LogType type, LogLevel level, const char *buff, bool flushFile); // NOLINT(readability-identifier-naming)
+
 private:
     static FILE *slogFile;
 };
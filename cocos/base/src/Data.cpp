@@ -74,11 +74,22 @@ void Data::move(Data &other) {
 
     _bytes = other._bytes;
     _size  = other._size;
+    _owner = std::move(other._owner);
 
     other._bytes = nullptr;
     other._size  = 0;
 }
 
+void Data::detachView() {
+    if (!_owner) {
+        return;
+    }
+    auto *bytes = static_cast<unsigned char *>(malloc(sizeof(unsigned char) * _size));
+    memcpy(bytes, _bytes, _size);
+    _bytes = bytes;
+    _owner.reset();
+}
+
 bool Data::isNull() const {
     return (_bytes == nullptr || _size == 0);
 }
@@ -102,9 +113,21 @@ void Data::copy(const unsigned char *bytes, ssize_t size) {
 }
 
 void Data::fastSet(unsigned char *bytes, ssize_t size) {
-    free(_bytes);
+    clear();
+    _bytes = bytes;
+    _size  = size;
+}
+
+void Data::setView(unsigned char *bytes, ssize_t size, std::shared_ptr<void> owner) {
+    CC_ASSERT(owner);
+    clear();
     _bytes = bytes;
     _size  = size;
+    _owner = std::move(owner);
+}
+
+bool Data::isView() const {
+    return _owner != nullptr;
 }
 
 void Data::resize(ssize_t size) {
@@ -112,17 +135,23 @@ void Data::resize(ssize_t size) {
     if (_size == size) {
         return;
     }
+    detachView();
     _size  = size;
     _bytes = static_cast<unsigned char *>(realloc(_bytes, sizeof(unsigned char) * _size));
 }
 
 void Data::clear() {
-    free(_bytes);
+    if (_owner) {
+        _owner.reset();
+    } else {
+        free(_bytes);
+    }
     _bytes = nullptr;
     _size  = 0;
 }
 
 unsigned char *Data::takeBuffer(ssize_t *size) {
+    detachView();
     auto *buffer = getBytes();
     if (size) {
         *size = getSize();
@@ -25,10 +25,17 @@
 
 #include "base/Log.h"
 
-#include <string>
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
     #ifndef WIN32_LEAN_AND_MEAN
@@ -63,15 +70,254 @@ LogLevel Log::slogLevel = LogLevel::INFO;
 FILE *                         Log::slogFile = nullptr;
 const std::vector<std::string> LOG_LEVEL_DESCS{"FATAL", "ERROR", "WARN", "INFO", "DEBUG"};
 
-void Log::setLogFile(const std::string &filename) {
+namespace {
+
+// A record holds a whole message formatted by logMessage, so it's never truncated in async mode.
+constexpr size_t                    LOG_BUFFER_SIZE = 4096;
+constexpr std::chrono::milliseconds LOG_FLUSH_INTERVAL{100};
+
+// Guards Log::slogFile, it's written by the async writer and logging threads while setLogFile or close may replace it.
+std::mutex gLogFileMutex;
+
+struct LogRecord {
+    std::atomic<size_t> sequence{0};
+    LogType             type{LogType::KERNEL};
+    LogLevel            level{LogLevel::INFO};
+    char                text[LOG_BUFFER_SIZE];
+};
+
+// Bounded lock-free multiple producers single consumer queue, every slot has a sequence number to tell whether it's writable or readable.
+class LogRingBuffer {
+public:
+    explicit LogRingBuffer(uint32_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _mask    = size - 1;
+        _records = std::make_unique<LogRecord[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            _records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(LogType type, LogLevel level, const char *text, size_t length) {
+        size_t     pos = _tail.load(std::memory_order_relaxed);
+        LogRecord *record;
+        for (;;) {
+            record       = &_records[pos & _mask];
+            size_t seq   = record->sequence.load(std::memory_order_acquire);
+            auto   delta = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (delta == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (delta < 0) {
+                return false; // full
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->type  = type;
+        record->level = level;
+        length = std::min(length, LOG_BUFFER_SIZE - 1);
+        memcpy(record->text, text, length);
+        record->text[length] = '\0';
+        record->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only invoked by the writer thread.
+    template <typename F>
+    bool pop(const F &consumer) {
+        LogRecord &record = _records[_head & _mask];
+        if (record.sequence.load(std::memory_order_acquire) != _head + 1) {
+            return false;
+        }
+        consumer(record);
+        record.sequence.store(_head + _mask + 1, std::memory_order_release);
+        ++_head;
+        return true;
+    }
+
+private:
+    std::unique_ptr<LogRecord[]> _records;
+    size_t                       _mask{0};
+    std::atomic<size_t>          _tail{0};
+    size_t                       _head{0};
+};
+
+class AsyncLogWriter {
+public:
+    explicit AsyncLogWriter(uint32_t capacity) : _buffer(capacity) {
+        _thread = std::thread([this]() { run(); });
+    }
+
+    ~AsyncLogWriter() {
+        _running.store(false, std::memory_order_release);
+        _cond.notify_one();
+        _thread.join();
+    }
+
+    void push(LogType type, LogLevel level, const char *text, size_t length) {
+        if (!_buffer.push(type, level, text, length)) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            _totalDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Only the first producer after the writer goes to sleep wakes it up.
+        if (!_pending.exchange(true, std::memory_order_acq_rel)) {
+            _cond.notify_one();
+        }
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        uint64_t                     target = ++_flushRequest;
+        _pending.store(true, std::memory_order_release);
+        _cond.notify_one();
+        _flushCond.wait(lock, [&]() { return _flushDone >= target; });
+    }
+
+    uint64_t getDroppedCount() const { return _totalDropped.load(std::memory_order_relaxed); }
+
+private:
+    void run() {
+        while (_running.load(std::memory_order_acquire)) {
+            uint64_t flushRequest = 0;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cond.wait_for(lock, LOG_FLUSH_INTERVAL, [this]() { return _pending.load(std::memory_order_acquire) || !_running.load(std::memory_order_acquire); });
+                _pending.store(false, std::memory_order_release);
+                flushRequest = _flushRequest;
+            }
+            drain();
+            if (flushRequest > 0) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _flushDone = flushRequest;
+                _flushCond.notify_all();
+            }
+        }
+        drain();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flushDone = _flushRequest;
+        _flushCond.notify_all();
+    }
+
+    void drain() {
+        bool written = false;
+        while (_buffer.pop([](const LogRecord &record) { Log::_writeRecord(record.type, record.level, record.text, false); })) {
+            written = true;
+        }
+        uint32_t dropped = _dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            char buff[64];
+            snprintf(buff, sizeof(buff), "[WARN]: %u log messages are dropped\n", dropped);
+            Log::_writeRecord(LogType::KERNEL, LogLevel::WARN, buff, false);
+            written = true;
+        }
+        if (written) {
+            {
+                std::lock_guard<std::mutex> lock(gLogFileMutex);
+                if (Log::getLogFile()) {
+                    fflush(Log::getLogFile());
+                }
+            }
+            fflush(stdout);
+        }
+    }
+
+    LogRingBuffer           _buffer;
+    std::thread             _thread;
+    std::mutex              _mutex;
+    std::condition_variable _cond;
+    std::condition_variable _flushCond;
+    std::atomic<bool>       _running{true};
+    std::atomic<bool>       _pending{false};
+    std::atomic<uint32_t>   _dropped{0};
+    std::atomic<uint64_t>   _totalDropped{0};
+    uint64_t                _flushRequest{0};
+    uint64_t                _flushDone{0};
+};
+
+std::unique_ptr<AsyncLogWriter> gAsyncWriter;
+std::atomic<AsyncLogWriter *>   gAsyncWriterPtr{nullptr};
+std::atomic<uint32_t>           gAsyncWriterUsers{0};
+
+// Threads using the writer are counted, setAsyncMode waits for them to leave before destroying it.
+class AsyncLogWriterRef {
+public:
+    AsyncLogWriterRef() {
+        gAsyncWriterUsers.fetch_add(1, std::memory_order_seq_cst);
+        _writer = gAsyncWriterPtr.load(std::memory_order_seq_cst);
+    }
+    ~AsyncLogWriterRef() {
+        gAsyncWriterUsers.fetch_sub(1, std::memory_order_release);
+    }
+    AsyncLogWriterRef(const AsyncLogWriterRef &) = delete;
+    AsyncLogWriterRef &operator=(const AsyncLogWriterRef &) = delete;
+
+    AsyncLogWriter *get() const { return _writer; }
+
+private:
+    AsyncLogWriter *_writer{nullptr};
+};
+
+// localtime is only invoked once per second per thread.
+int formatTimestamp(char *buff) {
+    thread_local time_t lastTime = 0;
+    thread_local char   timestamp[16];
+    time_t              ctTime = time(nullptr);
+    if (ctTime != lastTime) {
+        lastTime = ctTime;
+        struct tm tmTime;
 #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
-    if (slogFile) {
-        fclose(slogFile);
+        localtime_s(&tmTime, &ctTime);
+#else
+        localtime_r(&ctTime, &tmTime);
+#endif
+        snprintf(timestamp, sizeof(timestamp), "%02d:%02d:%02d ", tmTime.tm_hour, tmTime.tm_min, tmTime.tm_sec);
     }
+    memcpy(buff, timestamp, 9);
+    return 9;
+}
 
-    slogFile = fopen(filename.c_str(), "w");
+} // namespace
 
-    if (slogFile) {
+void Log::setAsyncMode(bool enabled, uint32_t capacity) {
+    // Logging from other threads is safe meanwhile, but setAsyncMode itself isn't expected to be invoked concurrently.
+    gAsyncWriterPtr.store(nullptr, std::memory_order_seq_cst);
+    while (gAsyncWriterUsers.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    gAsyncWriter.reset();
+    if (enabled) {
+        gAsyncWriter = std::make_unique<AsyncLogWriter>(capacity);
+        gAsyncWriterPtr.store(gAsyncWriter.get(), std::memory_order_seq_cst);
+    }
+}
+
+bool Log::isAsyncMode() {
+    return gAsyncWriterPtr.load(std::memory_order_acquire) != nullptr;
+}
+
+void Log::flush() {
+    AsyncLogWriterRef writer;
+    if (writer.get()) {
+        writer.get()->flush();
+    }
+}
+
+uint64_t Log::getDroppedCount() {
+    AsyncLogWriterRef writer;
+    return writer.get() ? writer.get()->getDroppedCount() : 0;
+}
+
+void Log::setLogFile(const std::string &filename) {
+#if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    FILE *file = fopen(filename.c_str(), "w");
+    if (file) {
         std::string msg;
         msg += "------------------------------------------------------\n";
 
@@ -92,13 +338,26 @@ void Log::setLogFile(const std::string &filename) {
 
         msg += "------------------------------------------------------\n";
 
-        fputs(msg.c_str(), slogFile);
-        fflush(slogFile);
+        fputs(msg.c_str(), file);
+        fflush(file);
+    }
+
+    // The old file is closed after being swapped out, the async writer or other threads may be writing to it.
+    FILE *oldFile = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gLogFileMutex);
+        oldFile  = slogFile;
+        slogFile = file;
+    }
+    if (oldFile) {
+        fclose(oldFile);
     }
 #endif
 }
 
 void Log::close() {
+    setAsyncMode(false);
+    std::lock_guard<std::mutex> lock(gLogFileMutex);
     if (slogFile) {
         fclose(slogFile);
         slogFile = nullptr;
@@ -106,17 +365,12 @@ void Log::close() {
 }
 
 void Log::logMessage(LogType type, LogLevel level, const char *formats, ...) {
-    char  buff[4096];
+    char  buff[LOG_BUFFER_SIZE];
     char *p    = buff;
     char *last = buff + sizeof(buff) - 3;
 
 #if defined(LOG_USE_TIMESTAMP)
-    struct tm *tmTime;
-    time_t     ctTime;
-    time(&ctTime);
-    tmTime = localtime(&ctTime);
-
-    p += sprintf(p, "%02d:%02d:%02d ", tmTime->tm_hour, tmTime->tm_min, tmTime->tm_sec);
+    p += formatTimestamp(p);
 #endif
 
     p += sprintf(p, "[%s]: ", LOG_LEVEL_DESCS[static_cast<int>(level)].c_str());
@@ -138,9 +392,29 @@ void Log::logMessage(LogType type, LogLevel level, const char *formats, ...) {
     *p++ = '\n';
     *p   = 0;
 
-    if (slogFile) {
-        fputs(buff, slogFile);
-        fflush(slogFile);
+    {
+        AsyncLogWriterRef writer;
+        if (writer.get()) {
+            if (level != LogLevel::FATAL) {
+                writer.get()->push(type, level, buff, static_cast<size_t>(p - buff));
+                return;
+            }
+            // Pending records are written first, so the context of a crash isn't lost or written after it.
+            writer.get()->flush();
+        }
+    }
+    _writeRecord(type, level, buff, true);
+}
+
+void Log::_writeRecord(LogType type, LogLevel level, const char *buff, bool flushFile) {
+    {
+        std::lock_guard<std::mutex> lock(gLogFileMutex);
+        if (slogFile) {
+            fputs(buff, slogFile);
+            if (flushFile) {
+                fflush(slogFile);
+            }
+        }
     }
 
 #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
@@ -195,6 +469,8 @@ void Log::logMessage(LogType type, LogLevel level, const char *formats, ...) {
             HILOG_DEBUG(LOG_APP, typeStr, buff);
     }
 #else
+    CC_UNUSED_PARAM(type);
+    CC_UNUSED_PARAM(level);
     fputs(buff, stdout);
 #endif
 }
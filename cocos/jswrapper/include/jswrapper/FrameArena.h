@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "Value.h"
+
+namespace se {
+
+/**
+ *  A thread-local stack of se::Value frames, used for arguments of native callbacks.
+ *  Frames are bump-allocated from blocks which are reused, so any arity is supported without heap allocation in most calls.
+ */
+class FrameArena final {
+public:
+    static const uint32_t BLOCK_SIZE = 256; // Values per block
+
+    /**
+     *  @brief Gets the arena of current thread.
+     */
+    static FrameArena &getInstance();
+
+    /**
+     *  @brief Pushes a frame of exactly count undefined values.
+     *  @return The first value of the frame, nullptr if count is 0.
+     */
+    Value *push(uint32_t count);
+
+    /**
+     *  @brief Pops the frame on top, only its values are destroyed.
+     *  @note Frames must be popped in the reverse order of pushing.
+     */
+    void pop(Value *frame, uint32_t count);
+
+    /**
+     *  @brief Releases the blocks above the one in use.
+     */
+    void trim();
+
+private:
+    struct Block {
+        explicit Block(uint32_t capacity);
+        inline Value *data() const { return reinterpret_cast<Value *>(storage.get()); }
+
+        std::unique_ptr<std::aligned_storage_t<sizeof(Value), alignof(Value)>[]> storage;
+        uint32_t                                                                 capacity{0};
+        uint32_t                                                                 top{0};
+    };
+
+    std::vector<Block> _blocks;
+    size_t             _current{0}; // Blocks before it are never empty.
+};
+
+/**
+ *  A frame of values pushed to the arena of current thread, it's popped in the destructor.
+ */
+class ValueFrame final {
+public:
+    explicit ValueFrame(uint32_t count)
+    : _arena(FrameArena::getInstance()), _data(_arena.push(count)), _size(count) {}
+    ~ValueFrame() { _arena.pop(_data, _size); }
+
+    ValueFrame(const ValueFrame &) = delete;
+    ValueFrame &operator=(const ValueFrame &) = delete;
+
+    inline Value *   data() const { return _data; }
+    inline uint32_t  size() const { return _size; }
+    inline Value &   operator[](uint32_t index) const { return _data[index]; }
+    inline operator ValueSpan() const { return {_data, _size}; } // NOLINT(google-explicit-constructor)
+
+private:
+    FrameArena &_arena;
+    Value *     _data;
+    uint32_t    _size;
+};
+
+} // namespace se
@@ -28,10 +28,58 @@
 
 #include "PrivateObject.h"
 #include "Value.h"
+#include "config.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    #include <array>
+    #include <type_traits>
+    #include "v8/Base.h"
+    #include "v8/Utils.h"
+#endif
 
 namespace se {
 
 class Object;
+class Class;
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+/**
+     *  Type tags of JavaScript arguments, used as bit masks by the overload dispatch of generated bindings.
+     */
+struct ArgType {
+    enum : uint8_t {
+        UNDEFINED = 1 << 0,
+        NULL_VALUE = 1 << 1,
+        BOOLEAN   = 1 << 2,
+        NUMBER    = 1 << 3,
+        STRING    = 1 << 4,
+        FUNCTION  = 1 << 5,
+        ARRAY     = 1 << 6, // Array, TypedArray or ArrayBuffer
+        OBJECT    = 1 << 7,
+
+        NULL_OR_UNDEFINED = UNDEFINED | NULL_VALUE,
+        ANY               = 0xFF,
+    };
+};
+
+/**
+     *  Type tags of all arguments of a call, computed once by `State::argTypes`.
+     */
+class ArgTypeList final {
+public:
+    static constexpr uint32_t MAX_ARGS = 16;
+
+    /**
+         *  @brief Tests whether the argument at index has one of the types in mask.
+         *  @note Arguments beyond MAX_ARGS always match.
+         */
+    inline bool match(uint32_t index, uint32_t mask) const {
+        return index >= MAX_ARGS || (_types[index] & mask) != 0;
+    }
+
+    std::array<uint8_t, MAX_ARGS> _types{};
+};
+#endif
 
 /**
      *  State represents an environment while a function or an accesstor is invoked from JavaScript.
@@ -46,9 +94,9 @@ public:
 
     /**
          *  @brief Gets the arguments of native binding functions or accesstors.
-         *  @return The arguments of native binding functions or accesstors.
+         *  @return The arguments of native binding functions or accesstors, they are valid until the State is destroyed.
          */
-    const ValueArray &args() const;
+    ValueSpan args() const;
 
     /**
          *  @brief Gets the JavaScript `this` object wrapped in se::Object.
@@ -62,6 +110,68 @@ public:
          */
     Value &rval();
 
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    /**
+         *  @brief Gets the argument count without converting any argument.
+         *  @return The argument count of native binding functions or accesstors.
+         */
+    uint32_t argCount() const;
+
+    /**
+         *  @brief Converts an argument on demand, the JavaScript value is read directly from the callback info.
+         *  @param[in] index The index of the argument, undefined is converted if it's out of range.
+         *  @return The argument converted to bool, arithmetic, enum or std::string type, T{} if it's an object or a symbol.
+         *          Integers are clamped to the range of T.
+         *  @note It doesn't trigger the conversion of `args()`, use `args()` for other types.
+         */
+    template <typename T>
+    T arg(uint32_t index) const;
+
+    /**
+         *  @brief Formats an argument for logging and appends it to out.
+         *  @param[in] index The index of the argument, undefined is formatted if it's out of range.
+         *  @param[out] out The text is appended to it, primitives as String() does, symbols as `Symbol(description)`, errors with their stack
+         *              and other objects by their toString. `[object ConstructorName]` is appended if toString throws, the exception is swallowed.
+         */
+    void appendArgToLog(uint32_t index, std::string *out) const;
+
+    /**
+         *  @brief Gets the type tags of arguments without converting them.
+         *  @return The type tags of arguments, see se::ArgType.
+         */
+    ArgTypeList argTypes() const;
+
+    /**
+         *  @brief Tests whether the argument is an instance of cls without converting it, used by generated bindings to select overloads.
+         *  @return true if the argument is an instance of cls or its subclasses, null or undefined. Also true if cls is nullptr.
+         */
+    bool argIsInstanceOf(uint32_t index, Class *cls) const;
+
+    /**
+         *  @brief Typed setters of the return value, they write the return value of the callback info directly.
+         *  @note In accessors `rval()` is set instead.
+         */
+    void returnBoolean(bool v);
+    void returnInt32(int32_t v);
+    void returnUint32(uint32_t v);
+    void returnDouble(double v);
+    void returnString(const std::string &v);
+
+    template <typename T>
+    void returnNumber(T v) {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "returnNumber only accepts arithmetic or enum");
+        if constexpr (std::is_enum<T>::value) {
+            returnNumber(static_cast<std::underlying_type_t<T>>(v));
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) <= sizeof(int32_t)) {
+            returnInt32(static_cast<int32_t>(v));
+        } else if constexpr (std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= sizeof(uint32_t)) {
+            returnUint32(static_cast<uint32_t>(v));
+        } else {
+            returnDouble(static_cast<double>(v));
+        }
+    }
+#endif
+
     // Private API used in wrapper
     /**
          *  @brief
@@ -78,16 +188,23 @@ public:
     ~State();
 
     explicit State(PrivateObjectBase *privateObject);
-    State(PrivateObjectBase *privateObject, const ValueArray &args);
+    State(PrivateObjectBase *privateObject, ValueSpan args);
     State(Object *thisObject, PrivateObjectBase *privateObject);
-    State(Object *thisObject, PrivateObjectBase *privateObject, const ValueArray &args);
+    State(Object *thisObject, PrivateObjectBase *privateObject, ValueSpan args);
 
     /**
          *  @brief
          *  @param[in]
          *  @return
          */
-    State(Object *thisObject, const ValueArray &args);
+    State(Object *thisObject, ValueSpan args);
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    /**
+         *  @brief Arguments are converted lazily from v8args to a frame of FrameArena when `args()` is invoked.
+         */
+    State(Object *thisObject, PrivateObjectBase *privateObject, const v8::FunctionCallbackInfo<v8::Value> &v8args);
+#endif
 
 private:
     // Disable copy/move constructor, copy/move assigment
@@ -98,7 +215,39 @@ private:
 
     PrivateObjectBase *_privateObject{nullptr};
     Object *           _thisObject{nullptr}; //weak ref
-    const ValueArray * _args{nullptr};       //weak ref
+    mutable ValueSpan  _args;                //weak ref
     Value              _retVal;              //weak ref
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    const v8::FunctionCallbackInfo<v8::Value> *_v8args{nullptr};   //weak ref
+    mutable Value *                            _lazyArgs{nullptr}; // frame pushed to FrameArena, popped in the destructor
+#endif
 };
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+template <typename T>
+T State::arg(uint32_t index) const {
+    static_assert(std::is_same<T, bool>::value || std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value,
+                  "State::arg only converts bool, arithmetic, enum and std::string, use State::args for other types");
+    if constexpr (std::is_enum<T>::value) {
+        return static_cast<T>(arg<std::underlying_type_t<T>>(index));
+    } else {
+        if (_v8args == nullptr) {
+            // Accessors and finalizers have converted arguments already.
+            const auto &values = args();
+            const Value &v     = index < values.size() ? values[index] : Value::Undefined;
+            if constexpr (std::is_same<T, bool>::value) {
+                return v.isNullOrUndefined() ? false : (v.isNumber() ? v.toDouble() != 0 : v.toBoolean());
+            } else if constexpr (std::is_integral<T>::value) {
+                return v.isNumber() || v.isBigInt() ? internal::clampToIntegral<T>(v.toDouble()) : T{};
+            } else if constexpr (std::is_arithmetic<T>::value) {
+                return v.isNumber() || v.isBigInt() ? static_cast<T>(v.toDouble()) : T{};
+            } else {
+                return v.isString() ? v.toString() : v.toStringForce();
+            }
+        }
+        return internal::jsToNativeValue<T>(_v8args->GetIsolate(), (*_v8args)[static_cast<int>(index)]);
+    }
+}
+#endif
+
 } // namespace se
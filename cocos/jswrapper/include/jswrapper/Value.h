@@ -488,6 +488,32 @@ private:
 using ValueArray = std::vector<Value>;
 extern ValueArray EmptyValueArray; // NOLINT(readability-identifier-naming)
 
+/**
+ *  A read-only view of contiguous se::Values, it doesn't own them.
+ */
+class ValueSpan final {
+public:
+    ValueSpan() = default;
+    ValueSpan(const Value *data, size_t size) : _data(data), _size(size) {}
+    ValueSpan(const ValueArray &arr) : _data(arr.data()), _size(arr.size()) {} // NOLINT(google-explicit-constructor)
+
+    inline const Value *data() const { return _data; }
+    inline size_t       size() const { return _size; }
+    inline bool         empty() const { return _size == 0; }
+    inline const Value &operator[](size_t index) const { return _data[index]; }
+    inline const Value *begin() const { return _data; }
+    inline const Value *end() const { return _data + _size; }
+
+    /**
+     *  @brief Copies the values, it's needed if they are used after the span is invalid.
+     */
+    inline ValueArray toArray() const { return ValueArray(begin(), end()); }
+
+private:
+    const Value *_data{nullptr};
+    size_t       _size{0};
+};
+
 } // namespace se
 
 using se_object_ptr = se::Object *; // NOLINT(readability-identifier-naming)
@@ -27,7 +27,7 @@
 #pragma once
 
 #include "../config.h"
-#include "../ValueArrayPool.h"
+#include "../FrameArena.h"
 
 //#define RECORD_JSB_INVOKING
 
@@ -101,9 +101,8 @@ void printJSBInvokeAtFrame(int n);
             JS::CallArgs   _argv = JS::CallArgsFromVp(argc, _vp);                                         \
             JS::RootedObject      _thizObj(_cx); \
             _argv.computeThis(_cx, &_thizObj); \
-            se::ValueArray &       args = se::gValueArrayPool.get(argc); \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth}; \
-            se::internal::jsToSeArgs(_cx, argc, _argv, args);                                            \
+            se::ValueFrame         args{argc}; \
+            se::internal::jsToSeArgs(_cx, argc, _argv, args.data());                                            \
             se::PrivateObjectBase *privateObject = static_cast<se::PrivateObjectBase *>(se::internal::getPrivate(_cx, _thizObj, 0));                  \
             se::Object *           thisObject    = reinterpret_cast<se::Object *>(se::internal::getPrivate(_cx, _thizObj, 1));       \
             se::State        state(thisObject, privateObject, args);                                               \
@@ -158,9 +157,8 @@ void printJSBInvokeAtFrame(int n);
             JsbInvokeScope(#funcName);                                                                    \
             bool           ret   = false;                                                                 \
             JS::CallArgs   _argv = JS::CallArgsFromVp(argc, _vp);                                         \
-            se::ValueArray &       args = se::gValueArrayPool.get(argc);                      \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                          \
-            se::internal::jsToSeArgs(_cx, argc, _argv, args);                                            \
+            se::ValueFrame         args{argc};                      \
+            se::internal::jsToSeArgs(_cx, argc, _argv, args.data());                                            \
             se::Object *thisObject = se::Object::_createJSObjectForConstructor(cls, _argv); \
             thisObject->_setFinalizeCallback(finalizeCb##Registry); \
             _argv.rval().setObject(*thisObject->_getJSObject());                                          \
@@ -207,11 +205,9 @@ void printJSBInvokeAtFrame(int n);
             _argv.computeThis(_cx, &_thizObj); \
             se::PrivateObjectBase * privateObject = static_cast<se::PrivateObjectBase *>(se::internal::getPrivate(_cx, _thizObj, 0));                  \
             se::Object *thisObject    = reinterpret_cast<se::Object *>(se::internal::getPrivate(_cx, _thizObj, 1));       \
-            se::ValueArray &       args          = se::gValueArrayPool.get(1);  \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                                                                          \
-            se::Value& data{args[0]}; \
+            se::Value data; \
             se::internal::jsToSeValue(_cx, _argv[0], &data);                                              \
-            se::State state(thisObject, privateObject, args);                                                      \
+            se::State state(thisObject, privateObject, se::ValueSpan(&data, 1));                                   \
             ret = funcName(state);                                                                        \
             if (!ret) {                                                                                   \
                 SE_LOGE("[ERROR] Failed to invoke %s, location: %s:%d\n", #funcName, __FILE__, __LINE__); \
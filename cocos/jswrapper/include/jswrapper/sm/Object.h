@@ -206,7 +206,7 @@ public:
          *  @param[out] rval The se::Value that results from calling object as a function, passing nullptr if return value is ignored.
          *  @return true if object is a function and there isn't any errors, otherwise false.
          */
-    bool call(const ValueArray &args, Object *thisObject, Value *rval = nullptr);
+    bool call(ValueSpan args, Object *thisObject, Value *rval = nullptr);
 
     /**
          *  @brief Tests whether an object is an array.
@@ -49,9 +49,9 @@ namespace internal {
 void        forceConvertJsValueToStdString(JSContext *cx, JS::HandleValue jsval, std::string *ret);
 std::string jsToStdString(JSContext *cx, JS::HandleString jsStr);
 
-void jsToSeArgs(JSContext *cx, int argc, const JS::CallArgs &argv, ValueArray &outArr);
+void jsToSeArgs(JSContext *cx, int argc, const JS::CallArgs &argv, Value *outArr);
 void jsToSeValue(JSContext *cx, JS::HandleValue jsval, Value *v);
-void seToJsArgs(JSContext *cx, const ValueArray &args, JS::RootedValueVector *outArr);
+void seToJsArgs(JSContext *cx, ValueSpan args, JS::RootedValueVector *outArr);
 void seToJsValue(JSContext *cx, const Value &v, JS::MutableHandleValue outVal);
 
 void setReturnValue(JSContext *cx, const Value &data, const JS::CallArgs &argv);
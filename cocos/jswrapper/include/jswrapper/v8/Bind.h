@@ -0,0 +1,238 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../config.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+    #include "Base.h"
+    #include "Utils.h"
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <string>
+    #include <tuple>
+    #include <type_traits>
+    #include <typeinfo>
+    #include <utility>
+
+namespace se {
+
+/**
+ * Converts arguments and return values of functions bound by `se::bind`.
+ * Specialize it to support more types, a specialization provides:
+ *   static T fromJs(v8::Isolate *isolate, v8::Local<v8::Value> jsval);
+ *   static v8::Local<v8::Value> toJs(v8::Isolate *isolate, const T &v);
+ */
+template <typename T, typename Enable = void>
+struct BindConverter {
+    static_assert(!std::is_same<T, T>::value, "se::bind doesn't support this type, specialize se::BindConverter for it");
+};
+
+template <typename T>
+struct BindConverter<T, std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value>> {
+    static T fromJs(v8::Isolate *isolate, v8::Local<v8::Value> jsval) {
+        return internal::jsToNativeValue<T>(isolate, jsval);
+    }
+
+    static v8::Local<v8::Value> toJs(v8::Isolate *isolate, const T &v) {
+        if constexpr (std::is_enum<T>::value) {
+            return BindConverter<std::underlying_type_t<T>>::toJs(isolate, static_cast<std::underlying_type_t<T>>(v));
+        } else if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) > sizeof(int32_t)) {
+            // Same as setReturnValue, 64-bit integers are returned as Number.
+            return v8::Number::New(isolate, static_cast<double>(v));
+        } else {
+            return internal::nativeToJsValue(isolate, v);
+        }
+    }
+};
+
+// Pointers to native binding objects are read from the private object of the JavaScript object.
+template <typename T>
+struct BindConverter<T *, std::enable_if_t<std::is_class<T>::value>> {
+    static T *fromJs(v8::Isolate *isolate, v8::Local<v8::Value> jsval) {
+        if (!jsval->IsObject() || !internal::hasPrivate(isolate, jsval)) {
+            return nullptr;
+        }
+        auto *privateObject = static_cast<PrivateObjectBase *>(internal::getPrivate(isolate, jsval, 0));
+        return privateObject != nullptr ? privateObject->get<std::remove_const_t<T>>() : nullptr;
+    }
+};
+
+namespace internal {
+
+template <typename F>
+struct BindTraits;
+
+template <typename R, typename... Args>
+struct BindTraits<R (*)(Args...)> {
+    using ClassType                        = void;
+    using ReturnType                       = R;
+    static constexpr size_t ARGUMENT_COUNT = sizeof...(Args);
+    template <size_t I>
+    using Arg = std::decay_t<std::tuple_element_t<I, std::tuple<Args...>>>;
+};
+
+template <typename C, typename R, typename... Args>
+struct BindTraits<R (C::*)(Args...)> : BindTraits<R (*)(Args...)> {
+    using ClassType = C;
+};
+
+template <typename C, typename R, typename... Args>
+struct BindTraits<R (C::*)(Args...) const> : BindTraits<R (*)(Args...)> {
+    using ClassType = C;
+};
+
+template <auto Func>
+struct BoundFunction {
+    using Traits = BindTraits<decltype(Func)>;
+    using C      = typename Traits::ClassType;
+    using R      = typename Traits::ReturnType;
+
+    template <size_t... I>
+    static void invoke(const v8::FunctionCallbackInfo<v8::Value> &v8args, v8::Isolate *isolate, C *self, std::index_sequence<I...> /*unused*/) {
+        if constexpr (std::is_void<R>::value) {
+            if constexpr (std::is_void<C>::value) {
+                Func(BindConverter<typename Traits::template Arg<I>>::fromJs(isolate, v8args[I])...);
+            } else {
+                (self->*Func)(BindConverter<typename Traits::template Arg<I>>::fromJs(isolate, v8args[I])...);
+            }
+        } else {
+            if constexpr (std::is_void<C>::value) {
+                v8args.GetReturnValue().Set(BindConverter<std::decay_t<R>>::toJs(
+                    isolate, Func(BindConverter<typename Traits::template Arg<I>>::fromJs(isolate, v8args[I])...)));
+            } else {
+                v8args.GetReturnValue().Set(BindConverter<std::decay_t<R>>::toJs(
+                    isolate, (self->*Func)(BindConverter<typename Traits::template Arg<I>>::fromJs(isolate, v8args[I])...)));
+            }
+        }
+    }
+
+    static void callback(const v8::FunctionCallbackInfo<v8::Value> &v8args) {
+        v8::Isolate *   isolate = v8args.GetIsolate();
+        v8::HandleScope hs(isolate);
+        if (v8args.Length() < static_cast<int>(Traits::ARGUMENT_COUNT)) {
+            SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", v8args.Length(), static_cast<int>(Traits::ARGUMENT_COUNT));
+            return;
+        }
+
+        C *self = nullptr;
+        if constexpr (!std::is_void<C>::value) {
+            auto *privateObject = static_cast<PrivateObjectBase *>(getPrivate(isolate, v8args.This(), 0));
+            self                = privateObject != nullptr ? privateObject->get<C>() : nullptr;
+            if (self == nullptr) {
+                SE_REPORT_ERROR("Invalid Native Object");
+                return;
+            }
+        }
+        invoke(v8args, isolate, self, std::make_index_sequence<Traits::ARGUMENT_COUNT>{});
+    }
+};
+
+template <typename T>
+void setFieldReturnValue(const v8::PropertyCallbackInfo<v8::Value> &info, T v) {
+    if constexpr (std::is_enum<T>::value) {
+        setFieldReturnValue(info, static_cast<std::underlying_type_t<T>>(v));
+    } else if constexpr (std::is_same<T, bool>::value) {
+        info.GetReturnValue().Set(v);
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) <= sizeof(int32_t)) {
+        info.GetReturnValue().Set(static_cast<int32_t>(v));
+    } else if constexpr (std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= sizeof(uint32_t)) {
+        info.GetReturnValue().Set(static_cast<uint32_t>(v));
+    } else {
+        info.GetReturnValue().Set(static_cast<double>(v));
+    }
+}
+
+template <typename M>
+struct MemberPointerTraits;
+
+template <typename C, typename T>
+struct MemberPointerTraits<T C::*> {
+    using Type = T;
+};
+
+// Accessors defined by `Class::defineField`, the field is accessed through the pointer to member.
+// Member may belong to a base of Class, the native object is cast to Class which is checked to be its exact type.
+template <typename Class, auto Member>
+struct FieldAccessor {
+    using T = typename MemberPointerTraits<decltype(Member)>::Type;
+
+    static T *field(v8::Isolate *isolate, v8::Local<v8::Object> thisObj) {
+        auto *privateObject = static_cast<PrivateObjectBase *>(getPrivate(isolate, thisObj, 0));
+        if (privateObject == nullptr || privateObject->getRaw() == nullptr) {
+            return nullptr;
+        }
+        // The native object must be exactly Class, it can't be cast from void * if it's a subclass.
+        const char *name = privateObject->getName();
+        if (name != typeid(Class).name() && strcmp(name, typeid(Class).name()) != 0) {
+            return nullptr;
+        }
+        return &(static_cast<Class *>(privateObject->getRaw())->*Member);
+    }
+
+    static void get(v8::Local<v8::Name> /*property*/, const v8::PropertyCallbackInfo<v8::Value> &info) {
+        const T *ptr = field(info.GetIsolate(), info.This());
+        if (ptr == nullptr) {
+            SE_REPORT_ERROR("Invalid Native Object");
+            return;
+        }
+        // No handle is created for the return value.
+        setFieldReturnValue(info, *ptr);
+    }
+
+    static void set(v8::Local<v8::Name> /*property*/, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info) {
+        T *ptr = field(info.GetIsolate(), info.This());
+        if (ptr == nullptr) {
+            SE_REPORT_ERROR("Invalid Native Object");
+            return;
+        }
+        *ptr = jsToNativeValue<T>(info.GetIsolate(), value);
+    }
+};
+
+} // namespace internal
+
+/**
+ *  @brief Generates a V8 callback for a member function or a free/static function at compile time.
+ *  @return The callback which can be passed to `Class::defineFunction` or `Class::defineStaticFunction`.
+ *  @note Parameter and return types are converted by se::BindConverter directly, no se::Value is involved.
+ *        Extra JavaScript arguments are ignored, missing ones are reported as errors.
+ *  @code
+ *  cls->defineFunction("fire", se::bind<&war::Tank::fire>());
+ *  @endcode
+ */
+template <auto Func>
+constexpr v8::FunctionCallback bind() {
+    return &internal::BoundFunction<Func>::callback;
+}
+
+} // namespace se
+
+#endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
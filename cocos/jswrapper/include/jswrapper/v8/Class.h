@@ -30,8 +30,10 @@
 
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
 
+    #include <type_traits>
     #include <vector>
     #include "Base.h"
+    #include "Bind.h"
 
 namespace se {
 
@@ -42,6 +44,8 @@ class Object;
      */
 class Class final {
 public:
+    using LazyInstallFunc = bool (*)(Object *ns);
+
     /**
          *  @brief Creates a class used for creating relevant native binding objects.
          *  @param[in] className A null-terminated UTF8 string containing the class's name.
@@ -74,6 +78,20 @@ public:
 
     bool defineProperty(const std::initializer_list<const char *> &names, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter);
 
+    /**
+         *  @brief Defines a property which reads and writes a field of the native object directly, e.g. `cls->defineField<Foo, &Foo::bar>("bar")`.
+         *  @param[in] name A null-terminated UTF8 string containing the property name.
+         *  @return true if succeed, otherwise false.
+         *  @note Only arithmetic and enum fields are supported, no se::State or se::Value is involved.
+         *        The native object must be exactly of type T, an error is reported for other types.
+         */
+    template <typename T, auto Member>
+    bool defineField(const char *name) {
+        using FieldType = typename internal::MemberPointerTraits<decltype(Member)>::Type;
+        static_assert(std::is_arithmetic<FieldType>::value || std::is_enum<FieldType>::value, "defineField only accepts arithmetic or enum fields");
+        return _defineField(name, &internal::FieldAccessor<T, Member>::get, &internal::FieldAccessor<T, Member>::set);
+    }
+
     /**
          *  @brief Defines a static function with a callback. Only JavaScript constructor object will have this function.
          *  @param[in] name A null-terminated UTF8 string containing the function name.
@@ -105,6 +123,32 @@ public:
          */
     bool install();
 
+    /**
+         *  @brief Defines a class which is created and installed the first time `ns[name]` is read.
+         *  @param[in] ns The object that the class constructor attaches to.
+         *  @param[in] name A null-terminated UTF8 string containing the property name of the class constructor.
+         *  @param[in] installFunc A callback creating the class with `ns` as its parent and installing it, e.g. a generated `js_register_*` function.
+         *  @return true if succeed, otherwise false.
+         *  @note installFunc must not access `ns[name]` itself.
+         */
+    static bool defineLazy(Object *ns, const char *name, LazyInstallFunc installFunc);
+
+    /**
+         *  @brief Installs a class defined by `defineLazy` immediately, e.g. its parent class or native objects of it are required before it's read.
+         *  @param[in] installFunc The callback passed to `defineLazy`.
+         *  @return true if the class is installed, false if it's not defined by `defineLazy` or fails to install.
+         */
+    static bool installLazy(LazyInstallFunc installFunc);
+
+    /**
+         *  @brief Creates native binding objects of this class in bulk.
+         *  @param[in] count The number of objects to create.
+         *  @param[out] out An array of at least count elements receiving the created objects.
+         *  @return true if succeed, otherwise false and no object is left in out.
+         *  @note Each object has to be released manually, the same as `Object::createObjectWithClass`.
+         */
+    bool createObjects(size_t count, Object **out);
+
     /**
          *  @brief Gets the proto object of this class.
          *  @return The proto object of this class.
@@ -120,6 +164,8 @@ public:
 
     // Private API used in wrapper
     V8FinalizeFunc _getFinalizeFunction() const; // NOLINT(readability-identifier-naming)
+    bool           _hasCtorHook(v8::Local<v8::Object> thisObj); // NOLINT(readability-identifier-naming)
+    bool           _hasInstance(v8::Local<v8::Value> value) const; // NOLINT(readability-identifier-naming)
 
 private:
     Class();
@@ -127,6 +173,8 @@ private:
 
     void setCreateProto(bool createProto);
 
+    bool _defineField(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter); // NOLINT(readability-identifier-naming)
+
     bool init(const std::string &clsName, Object *parent, Object *parentProto, v8::FunctionCallback ctor);
     void destroy();
 
@@ -34,7 +34,6 @@
 #include <type_traits>
 #include <typeinfo>
 #include <vector>
-#include "../ValueArrayPool.h"
 #include "../config.h"
 #include "base/Log.h"
 
@@ -112,17 +111,16 @@ void printJSBInvokeAtFrame(int n);
             bool                   ret      = false;                                                                                            \
             v8::Isolate *          _isolate = _v8args.GetIsolate();                                                                             \
             v8::HandleScope        _hs(_isolate);                                                                                               \
-            se::ValueArray &       args = se::gValueArrayPool.get(_v8args.Length());                                                            \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                                                                \
-            se::internal::jsToSeArgs(_v8args, args);                                                                                            \
             se::PrivateObjectBase *privateObject = static_cast<se::PrivateObjectBase *>(se::internal::getPrivate(_isolate, _v8args.This(), 0)); \
             se::Object *           thisObject    = reinterpret_cast<se::Object *>(se::internal::getPrivate(_isolate, _v8args.This(), 1));       \
-            se::State              state(thisObject, privateObject, args);                                                                      \
+            se::State              state(thisObject, privateObject, _v8args);                                                                   \
             ret = funcName(state);                                                                                                              \
             if (!ret) {                                                                                                                         \
                 SE_LOGE("[ERROR] Failed to invoke %s, location: %s:%d\n", #funcName, __FILE__, __LINE__);                                       \
             }                                                                                                                                   \
-            se::internal::setReturnValue(state.rval(), _v8args);                                                                                \
+            if (!state.rval().isUndefined()) {                                                                                                  \
+                se::internal::setReturnValue(state.rval(), _v8args);                                                                            \
+            }                                                                                                                                   \
         }
 
     #define SE_BIND_FUNC_FAST(funcName)                                                                                        \
@@ -153,23 +151,22 @@ void printJSBInvokeAtFrame(int n);
     #define SE_BIND_CTOR(funcName, cls, finalizeCb)                                                       \
         void funcName##Registry(const v8::FunctionCallbackInfo<v8::Value> &_v8args) {                     \
             JsbInvokeScope(#funcName);                                                                    \
-            v8::Isolate *          _isolate = _v8args.GetIsolate();                                       \
-            v8::HandleScope        _hs(_isolate);                                                         \
-            bool                   ret  = true;                                                           \
-            se::ValueArray &       args = se::gValueArrayPool.get(_v8args.Length());                      \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                          \
-            se::internal::jsToSeArgs(_v8args, args);                                                      \
-            se::Object *thisObject = se::Object::_createJSObject(cls, _v8args.This());                    \
+            v8::Isolate *   _isolate = _v8args.GetIsolate();                                              \
+            v8::HandleScope _hs(_isolate);                                                                \
+            bool            ret        = true;                                                            \
+            se::Object *    thisObject = se::Object::_createJSObject(cls, _v8args.This());                \
             thisObject->_setFinalizeCallback(_SE(finalizeCb));                                            \
-            se::State state(thisObject, args);                                                            \
+            se::State state(thisObject, nullptr, _v8args);                                                \
             ret = funcName(state);                                                                        \
             if (!ret) {                                                                                   \
                 SE_LOGE("[ERROR] Failed to invoke %s, location: %s:%d\n", #funcName, __FILE__, __LINE__); \
             }                                                                                             \
-            se::Value _property;                                                                          \
-            bool      _found = false;                                                                     \
-            _found           = thisObject->getProperty("_ctor", &_property);                              \
-            if (_found) _property.toObject()->call(args, thisObject);                                     \
+            if ((cls)->_hasCtorHook(_v8args.This())) {                                                    \
+                se::Value _property;                                                                      \
+                bool      _found = false;                                                                 \
+                _found           = thisObject->getProperty("_ctor", &_property);                          \
+                if (_found) _property.toObject()->call(state.args(), thisObject);                         \
+            }                                                                                             \
         }
 
     #define SE_BIND_PROP_GET_IMPL(funcName, postFix)                                                                                            \
@@ -199,11 +196,9 @@ void printJSBInvokeAtFrame(int n);
             bool                   ret           = true;                                                                                                  \
             se::PrivateObjectBase *privateObject = static_cast<se::PrivateObjectBase *>(se::internal::getPrivate(_isolate, _v8args.This(), 0));           \
             se::Object *           thisObject    = reinterpret_cast<se::Object *>(se::internal::getPrivate(_isolate, _v8args.This(), 1));                 \
-            se::ValueArray &       args          = se::gValueArrayPool.get(1);                                                                            \
-            se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                                                                          \
-            se::Value &            data{args[0]};                                                                                                         \
+            se::Value              data;                                                                                                                  \
             se::internal::jsToSeValue(_isolate, _value, &data);                                                                                           \
-            se::State state(thisObject, privateObject, args);                                                                                             \
+            se::State state(thisObject, privateObject, se::ValueSpan(&data, 1));                                                                          \
             ret = funcName(state);                                                                                                                        \
             if (!ret) {                                                                                                                                   \
                 SE_LOGE("[ERROR] Failed to invoke %s, location: %s:%d\n", #funcName, __FILE__, __LINE__);                                                 \
@@ -33,8 +33,12 @@
     #include "../RefCounter.h"
     #include "../Value.h"
     #include "Base.h"
+    #include "Bind.h"
     #include "ObjectWrap.h"
+    #include "StackTrace.h"
+    #include "Utils.h"
 
+    #include <array>
     #include <memory>
 
     // DEBUG ONLY:
@@ -45,6 +49,10 @@
 
     #define JSB_TRACK_OBJECT_CREATION 0
 
+namespace cc {
+class Data;
+}
+
 namespace se {
 
 class Class;
@@ -74,6 +82,15 @@ public:
          */
     static Object *createArrayObject(size_t length);
 
+    /**
+         *  @brief Creates a JavaScript Array Object holding existing objects, the array is created at once without setting elements one by one.
+         *  @param[in] elements A pointer to the objects to be stored in the array, nullptr elements are stored as null.
+         *  @param[in] count The number of elements.
+         *  @return A JavaScript Array Object, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createArrayObject(Object *const *elements, size_t count);
+
     /**
          *  @brief Creates a JavaScript Typed Array Object with uint8 format from an existing pointer.
          *  @param[in] bytes A pointer to the byte buffer to be used as the backing store of the Typed Array object.
@@ -108,6 +125,30 @@ public:
          */
     static Object *createTypedArray(TypedArrayType type, const void *data, size_t byteLength);
 
+    using TypedArrayFillFunc = std::function<void(uint8_t *data, size_t byteLength)>;
+
+    /**
+         *  @brief Creates a JavaScript Typed Array Object with specified format whose backing store isn't initialized,
+                   the producer writes the content directly into the backing store.
+         *  @param[in] type The format of typed array.
+         *  @param[in] byteLength The number of bytes of the backing store.
+         *  @param[in] fillFunc The callback which fills the whole backing store, it's invoked before this method returns.
+         *  @return A JavaScript Typed Array Object, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createTypedArrayUninitialized(TypedArrayType type, size_t byteLength, const TypedArrayFillFunc &fillFunc);
+
+    /**
+         *  @brief Creates a JavaScript Typed Array Object with specified format whose backing store isn't initialized.
+         *  @param[in] type The format of typed array.
+         *  @param[in] byteLength The number of bytes of the backing store.
+         *  @param[out] outData The pointer to the backing store, the caller has to fill all the bytes.
+         *  @return A JavaScript Typed Array Object, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         *        outData is valid as long as the returned object is alive.
+         */
+    static Object *createTypedArrayUninitialized(TypedArrayType type, size_t byteLength, uint8_t **outData);
+
     /**
          *  @brief Creates a JavaScript Typed Array Object with a se::Object, which is a ArrayBuffer,
                    if provide a null pointer,then will create a empty JavaScript Typed Array Object.
@@ -134,6 +175,14 @@ public:
     using BufferContentsFreeFunc = void (*)(void* contents, size_t byteLength, void* userData);
     static Object *createExternalArrayBufferObject(void* contents, size_t byteLength, BufferContentsFreeFunc freeFunc, void* freeUserData = nullptr);
 
+    /**
+         *  @brief Creates a JavaScript Array Buffer object which adopts the buffer of a cc::Data without copying.
+         *  @param[in] data The data whose buffer is moved into the Array Buffer, it's left empty after this call.
+         *  @return A Array Buffer Object whose backing store is the buffer of data, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createArrayBufferFromData(cc::Data &&data);
+
 
     /**
          *  @brief Creates a JavaScript Object from a JSON formatted string.
@@ -143,6 +192,23 @@ public:
          */
     static Object *createJSONObject(const std::string &jsonStr);
 
+    /**
+         *  @brief Creates a JavaScript Object from a JSON formatted buffer, e.g. a memory mapped file viewed by cc::Data.
+         *  @param[in] buffer The utf-8 encoded JSON text, it's not required to be null-terminated.
+         *  @return A JavaScript Object containing the parsed value, or nullptr if the input is invalid.
+         *  @note ASCII buffers are moved into external strings and parsed in place without being copied, V8 releases them once the strings are collected.
+         *        Other buffers are copied and left unchanged. The return value (non-null) has to be released manually.
+         */
+    static Object *createJSONObjectFromBuffer(cc::Data &&buffer);
+
+    /**
+         *  @brief Creates a pending Promise with v8::Promise::Resolver, no script is evaluated.
+         *  @param[out] promise The created Promise.
+         *  @return The resolver settling the promise by `resolvePromise` or `rejectPromise`, or nullptr if there is an error.
+         *  @note The return value (non-null) has to be released manually.
+         */
+    static Object *createPromiseResolver(Value *promise);
+
     /**
          *  @brief Creates a JavaScript Native Binding Object from an existing se::Class instance.
          *  @param[in] cls The se::Class instance which stores native callback informations.
@@ -226,7 +292,37 @@ public:
          *  @param[out] rval The se::Value that results from calling object as a function, passing nullptr if return value is ignored.
          *  @return true if object is a function and there isn't any errors, otherwise false.
          */
-    bool call(const ValueArray &args, Object *thisObject, Value *rval = nullptr);
+    bool call(ValueSpan args, Object *thisObject, Value *rval = nullptr);
+
+    /**
+         *  @brief Fulfills the promise of a resolver created by `createPromiseResolver`.
+         *  @param[in] value The fulfillment value.
+         *  @return true if succeed, otherwise false, e.g. this object isn't a resolver.
+         */
+    bool resolvePromise(const Value &value);
+
+    /**
+         *  @brief Rejects the promise of a resolver created by `createPromiseResolver`.
+         *  @param[in] reason The rejection reason.
+         *  @return true if succeed, otherwise false, e.g. this object isn't a resolver.
+         */
+    bool rejectPromise(const Value &reason);
+
+    /**
+         *  @brief Calls an object as a function with native arguments.
+         *  @param[in] thisObject The object to use as "this," or NULL to use the global object as "this."
+         *  @param[out] rval The se::Value that results from calling object as a function, passing nullptr if return value is ignored.
+         *  @param[in] args Arguments of bool, arithmetic, enum, string, se::Value or se::Object* type.
+         *  @return true if object is a function and there isn't any errors, otherwise false.
+         *  @note Arguments are converted to JavaScript values on the stack, no se::ValueArray is allocated.
+         */
+    template <typename... Args>
+    bool invoke(Object *thisObject, Value *rval, const Args &...args) {
+        v8::Isolate *                                      isolate = v8::Isolate::GetCurrent();
+        v8::HandleScope                                    handleScope(isolate);
+        std::array<v8::Local<v8::Value>, sizeof...(Args)> argv{{internal::nativeToJsValue(isolate, args)...}};
+        return _callWithArgv(thisObject, argv.size(), argv.data(), rval);
+    }
 
     /**
          *  @brief Tests whether an object is an array.
@@ -257,6 +353,42 @@ public:
          */
     bool setArrayElement(uint32_t index, const Value &data);
 
+    /**
+         *  @brief Converts all elements of an array object in one pass.
+         *  @param[out] out The vector to be stored for the elements, which are converted by se::BindConverter, e.g. arithmetic types or pointers to native binding objects.
+         *  @return true if succeed, otherwise false, e.g. an element is an object while T is arithmetic.
+         *  @note The length is read from the array directly and no se::Value is created for elements.
+         */
+    template <typename T, typename A>
+    bool getArrayElements(std::vector<T, A> *out) const {
+        assert(out != nullptr);
+        if (!isArray()) {
+            return false;
+        }
+        v8::Isolate *          isolate = v8::Isolate::GetCurrent();
+        v8::HandleScope        hs(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Local<v8::Array>   jsArray = _getJSObject().As<v8::Array>();
+        const uint32_t         length  = jsArray->Length();
+        out->resize(length);
+        for (uint32_t i = 0; i < length; ++i) {
+            v8::Local<v8::Value> element;
+            if (!jsArray->Get(context, i).ToLocal(&element)) {
+                return false;
+            }
+            if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value) {
+                T v{};
+                if (!internal::jsToNativeValue(isolate, element, &v)) {
+                    return false;
+                }
+                (*out)[i] = std::move(v);
+            } else {
+                (*out)[i] = BindConverter<T>::fromJs(isolate, element);
+            }
+        }
+        return true;
+    }
+
     /** @brief Tests whether an object is a typed array.
          *  @return true if object is a typed array, otherwise false.
          */
@@ -290,6 +422,14 @@ public:
          */
     bool getArrayBufferData(uint8_t **ptr, size_t *length) const;
 
+    /**
+         *  @brief Gets a cc::Data view of the backing store of an array buffer or typed array object.
+         *  @param[out] data The cc::Data which shares the backing store, the store is kept alive until data is cleared.
+         *  @return true if succeed, otherwise false.
+         *  @note The view doesn't copy any bytes and it may outlive this object.
+         */
+    bool getBackingStoreData(cc::Data *data) const;
+
     /**
          *  @brief Gets all property names of an object.
          *  @param[out] allKeys A string vector to store all property names.
@@ -428,6 +568,13 @@ public:
          */
     std::string toString() const;
 
+    /**
+         *  @brief Serializes current object with `JSON.stringify`.
+         *  @param[out] json The utf-8 JSON string to be stored, its capacity is reused.
+         *  @return true if succeed, otherwise false, e.g. the object contains cyclic references.
+         */
+    bool toJSON(std::string *json) const;
+
     std::string toStringExt() const;
 
     // Private API used in wrapper
@@ -454,6 +601,7 @@ private:
     ~Object() override;
 
     bool init(Class *cls, v8::Local<v8::Object> obj);
+    bool _callWithArgv(Object *thisObject, size_t argc, v8::Local<v8::Value> *argv, Value *rval); // NOLINT(readability-identifier-naming)
 
     Class *     _cls{nullptr};
     ObjectWrap  _obj;
@@ -468,7 +616,7 @@ private:
     uint32_t _objectId = 0;
     #endif
     #if JSB_TRACK_OBJECT_CREATION
-    std::string _objectCreationStackFrame;
+    StackTrace _objectCreationStackFrame;
     #endif
     friend class ScriptEngine;
 };
@@ -32,7 +32,11 @@
 
     #include "../Value.h"
     #include "Base.h"
+    #include "SourceMap.h"
+    #include "StackTrace.h"
+    #include "Utils.h"
 
+    #include <array>
     #include <thread>
 
     #if SE_ENABLE_INSPECTOR
@@ -134,6 +138,24 @@ public:
      *  @note This method will create JavaScript context and global object.
      */
     bool init(v8::Isolate *isolate);
+
+    enum class CodeCacheMode : uint8_t {
+        NONE,     // .bc files aren't used.
+        BYTECODE, // .bc files are used, bytecode flushing is disabled since their functions can't be compiled again from the dummy source.
+    };
+
+    struct CompileOptions {
+        bool          eagerCompile{false}; // Compiles all functions eagerly, scripts in .bc files are always compiled eagerly when they are generated.
+        bool          flushBytecode{true}; // Flushes bytecode of functions which haven't been run recently, it's ignored in CodeCacheMode::BYTECODE.
+        CodeCacheMode codeCache{CodeCacheMode::NONE};
+    };
+
+    /**
+     *  @brief Sets how scripts are compiled, it must be invoked before `init`. It has no effect if the isolate is given by `init(isolate)`.
+     *  @param[in] options The compile options.
+     */
+    void                  setCompileOptions(const CompileOptions &options);
+    const CompileOptions &getCompileOptions() const { return _compileOptions; }
     /**
      *  @brief Adds a hook function before initializing script engine.
      *  @param[in] hook A hook function to be invoked before initializing script engine.
@@ -192,6 +214,13 @@ public:
      */
     std::string getCurrentStackTrace();
 
+    /**
+     * @brief Configures the stack trace captured for uncaught exceptions, which is reported by exception callbacks.
+     * @param[in] frameLimit The max count of frames, 0 disables capturing.
+     * @param[in] detail The detail of frames.
+     */
+    void setUncaughtExceptionStackTrace(uint32_t frameLimit, StackTrace::Detail detail = StackTrace::Detail::OVERVIEW);
+
     /**
      *  Delegate class for file operation
      */
@@ -242,6 +271,61 @@ public:
      */
     const FileOperationDelegate &getFileOperationDelegate() const;
 
+    /**
+     *  @brief Enables mapping locations of exceptions to original sources by the `//# sourceMappingURL` of scripts.
+     *  @param[in] enabled Whether to enable source maps, only scripts evaluated after it's enabled are mapped.
+     *  @param[in] cacheDir The directory where decoded indexes are cached, passing an empty string to disable the cache.
+     *  @note Source maps are loaded through FileOperationDelegate when an exception is reported for the first time.
+     *        The cache is keyed by the url of source map and the length of script, so the cache directory should be cleared if scripts are updated in place.
+     */
+    void setSourceMapEnabled(bool enabled, const std::string &cacheDir = "");
+
+    /**
+     *  @brief Maps a location of generated script to its original source.
+     *  @param[in] scriptName The script name which is reported by stack frames.
+     *  @param[in] line The 1-based line.
+     *  @param[in] column The 1-based column.
+     *  @param[out] source The original source.
+     *  @param[out] originalLine The 1-based original line.
+     *  @param[out] originalColumn The 1-based original column.
+     *  @return true if succeed, otherwise false, e.g. the script has no source map.
+     */
+    bool symbolicate(const std::string &scriptName, int line, int column, std::string *source, int *originalLine, int *originalColumn);
+
+    /**
+     *  Delegate class for serializing native binding objects with `serialize` and `deserialize`.
+     */
+    class SerializeDelegate {
+    public:
+        // object, class of object (may be nullptr), private object (may be nullptr), payload to be appended; return false if the object can't be serialized.
+        std::function<bool(Object *, Class *, PrivateObjectBase *, std::vector<uint8_t> *)> onWriteNativeObject;
+        // class name written by onWriteNativeObject, payload, payload size; return a native binding object, e.g. from Object::createObjectWithClass, or nullptr if it fails. The engine takes no reference to it.
+        std::function<Object *(const char *, const uint8_t *, size_t)> onReadNativeObject;
+    };
+
+    /**
+     *  @brief Sets the delegate for serializing native binding objects.
+     *  @param delegate[in] The delegate instance, native binding objects can't be serialized without it.
+     */
+    void setSerializeDelegate(const SerializeDelegate &delegate);
+
+    /**
+     *  @brief Serializes a value with the structured clone algorithm, e.g. typed arrays, Maps, Sets and cyclic references are kept.
+     *  @param[in] value The value to be serialized.
+     *  @param[out] out The bytes to be stored.
+     *  @return true if succeed, otherwise false, e.g. the value contains functions.
+     */
+    bool serialize(const Value &value, std::vector<uint8_t> *out);
+
+    /**
+     *  @brief Deserializes a value from the bytes produced by `serialize`.
+     *  @param[in] data The serialized bytes.
+     *  @param[in] size The number of serialized bytes.
+     *  @param[out] value The deserialized value to be stored.
+     *  @return true if succeed, otherwise false.
+     */
+    bool deserialize(const uint8_t *data, size_t size, Value *value);
+
     /**
      *  @brief Executes a file which contains JavaScript code.
      *  @param[in] path Script file path.
@@ -250,6 +334,14 @@ public:
      */
     bool runScript(const std::string &path, Value *ret = nullptr);
 
+    /**
+     *  @brief Runs scripts in order, they are parsed in parallel by worker threads while the previous ones are running.
+     *  @param[in] paths The paths of scripts, ".bc" files are run by `runScript` in their turns.
+     *  @return true if all scripts succeed, otherwise false. Scripts after a failed one aren't run.
+     *  @note Files are read by FileOperationDelegate in the calling thread before any script is run, only the parsing is done by worker threads.
+     */
+    bool runScripts(const std::vector<std::string> &paths);
+
     /**
      *  @brief Tests whether script engine is doing garbage collection.
      *  @return true if it's in garbage collection, otherwise false.
@@ -297,6 +389,70 @@ public:
      */
     void setJSExceptionCallback(const ExceptionCallback &cb);
 
+    struct ExceptionFrame {
+        std::string functionName;
+        std::string scriptName;
+        int         line{0};
+        int         column{0};
+    };
+
+    /**
+     *  Structured record of a script exception, identical exceptions are merged into one record.
+     */
+    struct ExceptionRecord {
+        std::string                 message;
+        std::string                 resourceName;
+        int                         line{0};
+        int                         column{0};
+        std::vector<ExceptionFrame> frames;
+        uint32_t                    count{0}; // How many times the exception is fired since last report.
+
+        std::string getLocation() const;
+        std::string getStackString() const;
+    };
+
+    using ExceptionBatchCallback = std::function<void(const std::vector<ExceptionRecord> &, uint32_t)>; // records, count of dropped records
+
+    /**
+     *  @brief Sets the callback function which receives the captured exceptions in a batch.
+     *  @param[in] cb The callback function to be notified.
+     */
+    void setExceptionBatchCallback(const ExceptionBatchCallback &cb);
+
+    /**
+     *  @brief Configures how exceptions are reported.
+     *  @param[in] capacity The max count of distinct records kept between two reports, the oldest ones are dropped if it's exceeded.
+     *  @param[in] intervalInSeconds The minimum interval between two reports, 0 means exceptions are reported as soon as they are fired.
+     *  @note Exception callbacks, `__errorHandler` and the error log are triggered once per record while reporting.
+     */
+    void setExceptionReportOptions(size_t capacity, float intervalInSeconds);
+
+    /**
+     *  @brief Reports all the captured exceptions immediately.
+     */
+    void flushExceptions();
+
+    enum class ConsoleLevel : uint8_t {
+        LEVEL_DEBUG, // DEBUG is a macro on windows, so use LEVEL_DEBUG instead.
+        LOG,
+        INFO,
+        WARN,
+        ERR,
+        OFF,
+    };
+
+    /**
+     *  @brief Configures the console functions of JavaScript.
+     *  @param[in] level The minimum level to be output, console calls below it return before any argument is converted.
+     *  @param[in] forwardToBuiltinConsole Whether to forward console calls to the built-in console of the engine, e.g. for the debugger.
+     */
+    void setConsoleOptions(ConsoleLevel level, bool forwardToBuiltinConsole) {
+        _consoleLevel       = level;
+        _isConsoleForwarded = forwardToBuiltinConsole;
+    }
+    ConsoleLevel getConsoleLevel() const { return _consoleLevel; }
+    bool         isConsoleForwarded() const { return _isConsoleForwarded; }
+
     /**
      *  @brief Gets the start time of script engine.
      *  @return The start time of script engine.
@@ -321,6 +477,51 @@ public:
      */
     void mainLoopUpdate();
 
+    /**
+     *  @brief Posts a task to be run in the thread of script engine, it's safe to be invoked from any thread.
+     *  @param[in] task The task to be run in `mainLoopUpdate`.
+     *  @note Pending tasks are discarded when the engine is cleaned up.
+     */
+    void postTask(std::function<void()> task);
+
+    /**
+     *  @brief Runs a task in the worker threads of the V8 platform, script engine must not be accessed in the task.
+     *  @param[in] task The task to be run, use `postTask` to deliver its result to the thread of script engine.
+     */
+    void postBackgroundTask(std::function<void()> task);
+
+    /**
+     *  @brief Sets the budget of posted tasks run per `mainLoopUpdate`, the rest are run in next frames.
+     *  @param[in] maxTasks The max count of tasks per frame, 0 means unlimited.
+     *  @param[in] maxMilliseconds The max time spent per frame, 0 means unlimited.
+     */
+    void setTaskBudget(uint32_t maxTasks, float maxMilliseconds);
+
+    /**
+     *  @brief Runs posted tasks within the budget under one HandleScope, microtasks are performed once after them.
+     *  @return The count of tasks run.
+     */
+    uint32_t runPostedTasks();
+
+    enum class MemoryPressureLevel : uint8_t {
+        MODERATE, // Caches are trimmed, V8 decides how much garbage to collect.
+        CRITICAL, // Caches are trimmed and a full garbage collection is performed.
+    };
+
+    /**
+     *  @brief Releases memory held by caches of script engine and notifies V8, it should be invoked in the thread of script engine when the system reports low memory.
+     *  @param[in] level The level of memory pressure.
+     *  @note It's also invoked with CRITICAL level in next `mainLoopUpdate` after the heap limit of V8 is raised temporarily for being nearly reached.
+     */
+    void onMemoryPressure(MemoryPressureLevel level);
+
+    /**
+     *  @brief Adds a hook function to trim caches outside script engine in `onMemoryPressure`.
+     *  @param[in] hook A hook function to be invoked before V8 is notified.
+     *  @note Hook functions are removed when the engine is cleaned up.
+     */
+    void addMemoryPressureHook(const std::function<void(MemoryPressureLevel)> &hook);
+
     /**
      *  @brief Gets script virtual machine instance ID. Default value is 1, increase by 1 if `init` is invoked.
      */
@@ -331,11 +532,31 @@ public:
      */
     bool callFunction(Object *targetObj, const char *funcName, uint32_t argc, Value *args, Value *rval = nullptr);
 
+    /**
+     * @brief Calls a script function of targetObj with native arguments, which are converted to JavaScript values on the stack.
+     * @param[in] targetObj The object which owns the function, it's used as "this".
+     * @param[in] funcName The property name of the function.
+     * @param[out] rval The result of the function, passing nullptr if return value is ignored.
+     * @param[in] args Arguments of bool, arithmetic, enum, string, se::Value or se::Object* type.
+     * @return true if succeed, otherwise false.
+     */
+    template <typename... Args>
+    bool invokeFunction(Object *targetObj, const char *funcName, Value *rval, const Args &...args) {
+        v8::HandleScope                                    handleScope(_isolate);
+        std::array<v8::Local<v8::Value>, sizeof...(Args)> argv{{internal::nativeToJsValue(_isolate, args)...}};
+        return _callFunctionWithArgv(targetObj, funcName, argv.size(), argv.data(), rval);
+    }
+
     /**
      * @brief Handle all exceptions throwed by promise
      */
     void handlePromiseExceptions();
 
+    /**
+     * @brief Sets the max count of tracked promise rejections, rejections beyond it are counted but not reported in detail.
+     */
+    void setMaxTrackedPromiseRejections(size_t count) { _maxTrackedPromiseRejections = count; }
+
     // Private API used in wrapper
     class VMStringPool final {
     public:
@@ -363,26 +584,40 @@ private:
     static void onOOMErrorCallback(const char *location, bool isHeapOom);
     static void onMessageCallback(v8::Local<v8::Message> message, v8::Local<v8::Value> data);
     static void onPromiseRejectCallback(v8::PromiseRejectMessage msg);
+    static size_t onNearHeapLimitCallback(void *data, size_t currentHeapLimit, size_t initialHeapLimit);
 
     /**
      *  @brief Load the bytecode file and set the return value
      *  @param[in] path_bc The path of bytecode file.
      *  @param[in] ret The se::Value that results from evaluating script. Passing nullptr if you don't care about the result.
-     *  @return true if succeed, otherwise false.
+     *  @return true if succeed, otherwise false, e.g. CodeCacheMode::BYTECODE isn't set.
      */
     bool runByteCodeFile(const std::string &pathBc, Value *ret /* = nullptr */);
+    void applyCompileOptions();
+    bool runCompiledScript(v8::MaybeLocal<v8::Script> maybeScript, const std::string &sourceUrl, const char *fileName, const char *source, size_t length, Value *ret);
     void callExceptionCallback(const char *, const char *, const char *);
+    void recordException(v8::Local<v8::Message> message);
+    void symbolicateException(ExceptionRecord *record);
+    SourceMap *getSourceMap(const std::string &scriptName);
     bool callRegisteredCallback();
+    bool _callFunctionWithArgv(Object *targetObj, const char *funcName, size_t argc, v8::Local<v8::Value> *argv, Value *rval); // NOLINT(readability-identifier-naming)
     bool postInit();
-    // Struct to save exception info
-    struct PromiseExceptionMsg {
-        std::string event;
-        std::string stackTrace;
+    // Rejection info of a tracked promise, the report is only formatted if it's still unhandled in `handlePromiseExceptions`.
+    struct PromiseRejection {
+        const char *               event{nullptr};
+        v8::Global<v8::Promise>    promise;
+        v8::Global<v8::Value>      value;
+        StackTrace                 stack;
     };
-    // Push promise and exception msg to _promiseArray
-    void pushPromiseExeception(const v8::Local<v8::Promise> &promise, const char *event, const char *stackTrace);
+    // Tracks a rejection event of the promise, it's keyed by the identity hash of the promise.
+    void trackPromiseRejection(v8::Local<v8::Promise> promise, const char *event, v8::Local<v8::Value> value, StackTrace &&stack);
 
-    std::vector<std::tuple<std::unique_ptr<v8::Persistent<v8::Promise>>, std::vector<PromiseExceptionMsg>>> _promiseArray;
+    std::unordered_multimap<int, PromiseRejection> _promiseRejections;
+    size_t                                         _maxTrackedPromiseRejections{1024};
+    uint32_t                                       _droppedPromiseRejectionCount{0};
+    StackTrace                                     _lastPromiseStackTrace;
+    uint32_t                                       _uncaughtStackFrameLimit{StackTrace::DEFAULT_FRAME_LIMIT};
+    StackTrace::Detail                             _uncaughtStackDetail{StackTrace::Detail::OVERVIEW};
 
     std::chrono::steady_clock::time_point _startTime;
     std::vector<RegisterCallback>         _registerCallbackArray;
@@ -392,6 +627,8 @@ private:
     std::vector<std::function<void()>>    _beforeCleanupHookArray;
     std::vector<std::function<void()>>    _afterCleanupHookArray;
 
+    std::vector<std::function<void(MemoryPressureLevel)>> _memoryPressureHookArray;
+
     v8::Persistent<v8::Context> _context;
 
     v8::Isolate *    _isolate;
@@ -401,8 +638,39 @@ private:
     Object *         _gcFunc = nullptr;
 
     FileOperationDelegate _fileOperationDelegate;
+    SerializeDelegate     _serializeDelegate;
     ExceptionCallback     _nativeExceptionCallback = nullptr;
     ExceptionCallback     _jsExceptionCallback     = nullptr;
+    ExceptionBatchCallback _exceptionBatchCallback = nullptr;
+
+    std::vector<ExceptionRecord>          _exceptionRecords;
+    std::vector<size_t>                   _exceptionRecordKeys;
+    size_t                                _exceptionRecordHead{0};
+    size_t                                _exceptionRecordCapacity{32};
+    uint32_t                              _droppedExceptionCount{0};
+    std::chrono::steady_clock::duration   _exceptionReportInterval{0};
+    std::chrono::steady_clock::time_point _lastExceptionReportTime;
+    bool                                  _isFlushingExceptions{false};
+
+    struct SourceMapEntry {
+        std::string                mapPath;
+        std::string                fingerprint;
+        std::unique_ptr<SourceMap> sourceMap;
+        bool                       isLoaded{false};
+    };
+    std::unordered_map<std::string, SourceMapEntry> _sourceMaps; // Keyed by script name.
+    std::string                                     _sourceMapCacheDir;
+    bool                                            _isSourceMapEnabled{false};
+
+    CompileOptions _compileOptions;
+
+    class TaskQueue;
+    std::unique_ptr<TaskQueue>          _taskQueue;
+    uint32_t                            _maxTasksPerTick{0};
+    std::chrono::steady_clock::duration _maxTaskTimePerTick{std::chrono::milliseconds(4)};
+
+    ConsoleLevel _consoleLevel{ConsoleLevel::LEVEL_DEBUG};
+    bool         _isConsoleForwarded{true};
 
     #if SE_ENABLE_INSPECTOR
     node::Environment *_env;
@@ -411,7 +679,6 @@ private:
     VMStringPool _stringPool;
 
     std::thread::id _engineThreadId;
-    std::string     _lastStackTrace;
     std::string     _debuggerServerAddr;
     uint32_t        _debuggerServerPort;
     bool            _isWaitForConnect;
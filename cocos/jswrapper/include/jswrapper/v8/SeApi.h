@@ -26,8 +26,10 @@
 
 #pragma once
 
+#include "Bind.h"
 #include "Class.h"
 #include "HelperMacros.h"
 #include "Object.h"
 #include "ScriptEngine.h"
+#include "StackTrace.h"
 #include "Utils.h"
@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../config.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+    #include "Base.h"
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+
+namespace se {
+
+/**
+ * SourceMap is a compact index of a source map (revision 3), the VLQ mappings are decoded once into segments sorted by generated position.
+ * All lines and columns are 0-based.
+ */
+class SourceMap final {
+public:
+    /**
+     *  @brief Parses a source map in JSON format.
+     *  @param[in] json The content of source map.
+     *  @param[in] length The length of content.
+     *  @return true if succeed, otherwise false.
+     *  @note It must be invoked in the thread of script engine, the JSON is parsed by the engine.
+     */
+    bool parse(const char *json, size_t length);
+
+    /**
+     *  @brief Loads the index saved by `saveIndex`.
+     *  @param[in] data The saved index.
+     *  @param[in] size The size of saved index.
+     *  @param[in] fingerprint The fingerprint of source map, loading fails if it doesn't match the saved one.
+     *  @return true if succeed, otherwise false.
+     */
+    bool loadIndex(const uint8_t *data, size_t size, const std::string &fingerprint);
+
+    /**
+     *  @brief Saves the decoded index to bytes.
+     *  @param[in] fingerprint The fingerprint of source map, e.g. its url, the length and the hash of the script.
+     *  @return The saved index.
+     */
+    std::string saveIndex(const std::string &fingerprint) const;
+
+    /**
+     *  @brief Finds the original location of a generated location.
+     *  @param[in] line The generated line.
+     *  @param[in] column The generated column.
+     *  @param[out] source The original source file.
+     *  @param[out] originalLine The original line.
+     *  @param[out] originalColumn The original column.
+     *  @param[out] name The original name, it's empty if there is no name in the mapping. Passing nullptr if you don't care about it.
+     *  @return true if found, otherwise false.
+     */
+    bool lookup(uint32_t line, uint32_t column, std::string *source, uint32_t *originalLine, uint32_t *originalColumn, std::string *name = nullptr) const;
+
+    bool isEmpty() const { return _segments.empty(); }
+
+private:
+    static constexpr uint32_t NO_NAME = 0xFFFFFFFF;
+
+    struct Segment {
+        uint32_t column;
+        uint32_t source;
+        uint32_t originalLine;
+        uint32_t originalColumn;
+        uint32_t name;
+    };
+
+    bool decodeMappings(const char *mappings, size_t length);
+
+    std::vector<std::string> _sources;
+    std::vector<std::string> _names;
+    std::vector<uint32_t>    _lineOffsets; // Segments of generated line i are in [_lineOffsets[i], _lineOffsets[i + 1]).
+    std::vector<Segment>     _segments;
+};
+
+} // namespace se
+
+#endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
@@ -0,0 +1,107 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include "../config.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+    #include "Base.h"
+
+    #include <string>
+
+namespace se {
+
+/**
+ * StackTrace holds the raw JavaScript stack trace, frames are only symbolized to strings while they're read.
+ */
+class StackTrace final {
+public:
+    static constexpr uint32_t DEFAULT_FRAME_LIMIT = 20;
+
+    enum class Detail : uint8_t {
+        OVERVIEW, // function name, script name, line and column
+        DETAILED, // also script id, whether it's eval or constructor
+    };
+
+    struct Frame {
+        std::string functionName;
+        std::string scriptName;
+        int         scriptId{0};
+        int         line{0};
+        int         column{0};
+    };
+
+    /**
+     *  @brief Captures the stack trace of current JavaScript execution.
+     *  @param[in] frameLimit The max count of frames to be captured.
+     *  @param[in] detail The detail of frames to be captured.
+     *  @return The captured stack trace, it's empty if no JavaScript is running.
+     */
+    static StackTrace capture(uint32_t frameLimit = DEFAULT_FRAME_LIMIT, Detail detail = Detail::OVERVIEW);
+
+    StackTrace() = default;
+    explicit StackTrace(v8::Local<v8::StackTrace> stack);
+    StackTrace(StackTrace &&other) noexcept;
+    StackTrace &operator=(StackTrace &&other) noexcept;
+    StackTrace(const StackTrace &) = delete;
+    StackTrace &operator=(const StackTrace &) = delete;
+    ~StackTrace() = default;
+
+    bool     isEmpty() const { return _stack.IsEmpty(); }
+    uint32_t getFrameCount() const;
+
+    /**
+     *  @brief Symbolizes a frame.
+     *  @param[in] index The index of the frame, 0 is the innermost one.
+     *  @param[out] frame The frame info to be stored.
+     *  @return true if succeed, otherwise false.
+     */
+    bool getFrame(uint32_t index, Frame *frame) const;
+
+    /**
+     *  @brief Symbolizes all frames to a string, the result is cached.
+     *  @return The formatted string, e.g. " - [0]foo@bar.js:10", frames are separated by line breaks.
+     */
+    const std::string &toString() const;
+
+    /**
+     *  @brief Releases the raw stack trace, it should be invoked before the isolate is disposed if the StackTrace lives longer.
+     */
+    void reset();
+
+    v8::Local<v8::StackTrace> _getStackTrace() const; // NOLINT(readability-identifier-naming)
+
+private:
+    v8::Global<v8::StackTrace> _stack;
+    mutable std::string         _cachedString;
+    mutable bool                _isSymbolized{false};
+};
+
+} // namespace se
+
+#endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
@@ -34,6 +34,11 @@
     #include "Base.h"
     #include "ObjectWrap.h"
 
+    #include <cmath>
+    #include <limits>
+    #include <string>
+    #include <type_traits>
+
 namespace se {
 
 namespace internal {
@@ -43,9 +48,9 @@ struct PrivateData {
     Object *           seObj{nullptr};
 };
 
-void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &_v8args, ValueArray &outArr);
+void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &_v8args, Value *outArr);
 void jsToSeValue(v8::Isolate *isolate, v8::Local<v8::Value> jsval, Value *v);
-void seToJsArgs(v8::Isolate *isolate, const ValueArray &args, v8::Local<v8::Value> *outArr);
+void seToJsArgs(v8::Isolate *isolate, ValueSpan args, v8::Local<v8::Value> *outArr);
 void seToJsValue(v8::Isolate *isolate, const Value &v, v8::Local<v8::Value> *outJsVal);
 
 void setReturnValue(const Value &data, const v8::FunctionCallbackInfo<v8::Value> &argv);
@@ -56,6 +61,137 @@ void  setPrivate(v8::Isolate *isolate, ObjectWrap &wrap, PrivateObjectBase *data
 void *getPrivate(v8::Isolate *isolate, v8::Local<v8::Value> value, uint32_t index = 0);
 void  clearPrivate(v8::Isolate *isolate, ObjectWrap &wrap);
 
+/**
+ * Converts a native argument to a JavaScript value without going through se::Value.
+ * Used by the variadic `Object::invoke` and `ScriptEngine::invokeFunction`.
+ */
+v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, Object *obj);
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, const Value &v) {
+    v8::Local<v8::Value> ret;
+    seToJsValue(isolate, v, &ret);
+    return ret;
+}
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, bool v) {
+    return v8::Boolean::New(isolate, v);
+}
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, std::nullptr_t /*v*/) {
+    return v8::Null(isolate);
+}
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, const char *v) {
+    if (v == nullptr) {
+        return v8::Null(isolate);
+    }
+    v8::MaybeLocal<v8::String> str = v8::String::NewFromUtf8(isolate, v, v8::NewStringType::kNormal);
+    return str.IsEmpty() ? v8::Local<v8::Value>() : v8::Local<v8::Value>(str.ToLocalChecked());
+}
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, const std::string &v) {
+    v8::MaybeLocal<v8::String> str = v8::String::NewFromUtf8(isolate, v.data(), v8::NewStringType::kNormal, static_cast<int>(v.length()));
+    return str.IsEmpty() ? v8::Local<v8::Value>() : v8::Local<v8::Value>(str.ToLocalChecked());
+}
+
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate * /*isolate*/, v8::Local<v8::Value> v) {
+    return v;
+}
+
+// Converted the same way as nativevalue_to_se does: enums become int32, only int64_t and uint64_t become BigInt.
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value>>
+inline v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, T v) {
+    if constexpr (std::is_enum<T>::value) {
+        return v8::Integer::New(isolate, static_cast<int32_t>(v));
+    } else if constexpr (std::is_same<T, int64_t>::value || std::is_same<T, uint64_t>::value) {
+        return v8::BigInt::New(isolate, static_cast<int64_t>(v));
+    } else if constexpr (std::is_integral<T>::value && sizeof(T) <= sizeof(int32_t)) {
+        if constexpr (std::is_signed<T>::value) {
+            return v8::Integer::New(isolate, static_cast<int32_t>(v));
+        } else {
+            return v8::Integer::NewFromUnsigned(isolate, static_cast<uint32_t>(v));
+        }
+    } else {
+        return v8::Number::New(isolate, static_cast<double>(v));
+    }
+}
+
+// Casting NaN or out of range doubles to integers is undefined, they are clamped to the range of T, NaN becomes 0.
+template <typename T>
+T clampToIntegral(double v) {
+    static_assert(std::is_integral<T>::value, "T must be integral");
+    if (std::isnan(v)) {
+        return T{};
+    }
+    if (v <= static_cast<double>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if (v >= static_cast<double>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(v);
+}
+
+/**
+ * Converts a JavaScript value to bool, arithmetic, enum or std::string without going through se::Value.
+ * No script is run: objects and symbols aren't converted since valueOf/toString could throw, false is returned for them and out is set to T{}.
+ */
+template <typename T>
+bool jsToNativeValue(v8::Isolate *isolate, v8::Local<v8::Value> jsval, T *out) {
+    if constexpr (std::is_enum<T>::value) {
+        std::underlying_type_t<T> v{};
+        bool                      ok = jsToNativeValue(isolate, jsval, &v);
+        *out                         = static_cast<T>(v);
+        return ok;
+    } else if constexpr (std::is_same<T, bool>::value) {
+        *out = jsval->BooleanValue(isolate);
+        return true;
+    } else {
+        *out = T{};
+        if (jsval->IsObject() || jsval->IsSymbol()) {
+            return false;
+        }
+        if constexpr (std::is_integral<T>::value) {
+            if (jsval->IsInt32()) {
+                *out = clampToIntegral<T>(jsval.As<v8::Int32>()->Value());
+            } else if (jsval->IsBigInt()) {
+                if constexpr (std::is_signed<T>::value) {
+                    int64_t v = jsval.As<v8::BigInt>()->Int64Value();
+                    *out      = sizeof(T) < sizeof(int64_t) ? clampToIntegral<T>(static_cast<double>(v)) : static_cast<T>(v);
+                } else {
+                    uint64_t v = jsval.As<v8::BigInt>()->Uint64Value();
+                    *out       = sizeof(T) < sizeof(uint64_t) ? clampToIntegral<T>(static_cast<double>(v)) : static_cast<T>(v);
+                }
+            } else {
+                // Converting primitives to number doesn't run any script.
+                *out = clampToIntegral<T>(jsval->IsNumber() ? jsval.As<v8::Number>()->Value() : jsval->NumberValue(isolate->GetCurrentContext()).FromMaybe(0.0));
+            }
+        } else if constexpr (std::is_floating_point<T>::value) {
+            if (jsval->IsNumber()) {
+                *out = static_cast<T>(jsval.As<v8::Number>()->Value());
+            } else if (jsval->IsBigInt()) {
+                *out = static_cast<T>(jsval.As<v8::BigInt>()->Int64Value());
+            } else {
+                *out = static_cast<T>(jsval->NumberValue(isolate->GetCurrentContext()).FromMaybe(0.0));
+            }
+        } else {
+            static_assert(std::is_same<T, std::string>::value, "jsToNativeValue only converts bool, arithmetic, enum and std::string");
+            v8::String::Utf8Value str(isolate, jsval);
+            if (*str != nullptr) {
+                out->assign(*str, str.length());
+            }
+        }
+        return true;
+    }
+}
+
+template <typename T>
+T jsToNativeValue(v8::Isolate *isolate, v8::Local<v8::Value> jsval) {
+    T ret{};
+    jsToNativeValue(isolate, jsval, &ret);
+    return ret;
+}
+
 } // namespace internal
 } // namespace se
 
@@ -0,0 +1,98 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2021 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "FrameArena.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include "config.h"
+
+namespace se {
+
+FrameArena::Block::Block(uint32_t capacity)
+: storage(std::make_unique<std::aligned_storage_t<sizeof(Value), alignof(Value)>[]>(capacity)),
+  capacity(capacity) {}
+
+FrameArena &FrameArena::getInstance() {
+    static thread_local FrameArena instance;
+    return instance;
+}
+
+Value *FrameArena::push(uint32_t count) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    if (SE_UNLIKELY(_blocks.empty())) {
+        _blocks.emplace_back(std::max(BLOCK_SIZE, count));
+    }
+
+    Block *block = &_blocks[_current];
+    if (SE_UNLIKELY(block->top + count > block->capacity)) {
+        if (block->top == 0) {
+            // Grows the empty block in place, blocks before the current one must not be empty.
+            *block = Block(std::max(BLOCK_SIZE, count));
+        } else {
+            ++_current;
+            if (_current == _blocks.size() || _blocks[_current].capacity < count) {
+                _blocks.emplace(_blocks.begin() + static_cast<std::ptrdiff_t>(_current), std::max(BLOCK_SIZE, count));
+            }
+            block = &_blocks[_current];
+        }
+    }
+
+    Value *frame = block->data() + block->top;
+    for (uint32_t i = 0; i < count; ++i) {
+        new (frame + i) Value();
+    }
+    block->top += count;
+    return frame;
+}
+
+void FrameArena::pop(Value *frame, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        frame[i].~Value();
+    }
+
+    Block &block = _blocks[_current];
+    assert(block.top >= count && frame + count == block.data() + block.top); // NOLINT
+    block.top -= count;
+    if (block.top == 0 && _current > 0) {
+        --_current;
+    }
+}
+
+void FrameArena::trim() {
+    if (_current + 1 < _blocks.size()) {
+        _blocks.erase(_blocks.begin() + static_cast<std::ptrdiff_t>(_current + 1), _blocks.end());
+    }
+}
+
+} // namespace se
@@ -26,26 +26,154 @@
 
 #include "State.h"
 #include "Object.h"
+#include "FrameArena.h"
+#include <algorithm>
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    #include "v8/Class.h"
+    #include "v8/Utils.h"
+#endif
 
 namespace se {
 
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+namespace {
+uint8_t getArgType(v8::Local<v8::Value> jsval) {
+    if (jsval->IsUndefined()) {
+        return ArgType::UNDEFINED;
+    }
+    if (jsval->IsNull()) {
+        return ArgType::NULL_VALUE;
+    }
+    if (jsval->IsBoolean()) {
+        return ArgType::BOOLEAN;
+    }
+    if (jsval->IsNumber() || jsval->IsBigInt()) {
+        return ArgType::NUMBER;
+    }
+    if (jsval->IsString()) {
+        return ArgType::STRING;
+    }
+    if (jsval->IsFunction()) {
+        return ArgType::FUNCTION;
+    }
+    if (jsval->IsArray() || jsval->IsArrayBufferView() || jsval->IsArrayBuffer()) {
+        return ArgType::ARRAY;
+    }
+    if (jsval->IsObject()) {
+        return ArgType::OBJECT;
+    }
+    return 0;
+}
+
+// Writes a string to the end of out, out keeps its capacity so the console buffer isn't reallocated.
+void appendUtf8(v8::Isolate *isolate, v8::Local<v8::String> str, std::string *out) {
+    const size_t offset = out->length();
+    const int    length = str->Utf8Length(isolate);
+    out->resize(offset + length);
+    str->WriteUtf8(isolate, &(*out)[offset], length, nullptr, v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+}
+
+void appendConstructorName(v8::Isolate *isolate, v8::Local<v8::Object> obj, std::string *out) {
+    out->append("[object ");
+    appendUtf8(isolate, obj->GetConstructorName(), out);
+    out->append("]");
+}
+
+// Errors are printed with their stack, other objects by toString. Exceptions thrown by them are caught, the constructor name is printed instead.
+void appendLogString(v8::Isolate *isolate, v8::Local<v8::Value> jsval, std::string *out) {
+    if (jsval->IsSymbol()) {
+        out->append("Symbol(");
+        v8::Local<v8::Value> description = jsval.As<v8::Symbol>()->Description();
+        if (description->IsString()) {
+            appendUtf8(isolate, description.As<v8::String>(), out);
+        }
+        out->append(")");
+        return;
+    }
+
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    if (!jsval->IsObject()) {
+        // Primitives other than symbols are converted without running any script.
+        appendUtf8(isolate, jsval->ToString(context).ToLocalChecked(), out);
+        return;
+    }
+
+    v8::Local<v8::Object> obj = jsval.As<v8::Object>();
+    v8::TryCatch          tryCatch(isolate);
+    v8::Local<v8::Value>  text;
+    if (jsval->IsNativeError()) {
+        // The stack of V8 starts with the message, the message is used if the stack is removed.
+        if (!obj->Get(context, v8::String::NewFromUtf8Literal(isolate, "stack")).ToLocal(&text) || !text->IsString()) {
+            if (!obj->Get(context, v8::String::NewFromUtf8Literal(isolate, "message")).ToLocal(&text) || !text->IsString()) {
+                text.Clear();
+            }
+        }
+    } else {
+        v8::Local<v8::String> str;
+        if (obj->ToString(context).ToLocal(&str)) {
+            text = str;
+        }
+    }
+    if (text.IsEmpty()) {
+        appendConstructorName(isolate, obj, out);
+    } else {
+        appendUtf8(isolate, text.As<v8::String>(), out);
+    }
+}
+
+uint8_t getArgType(const Value &value) {
+    switch (value.getType()) {
+        case Value::Type::Undefined:
+            return ArgType::UNDEFINED;
+        case Value::Type::Null:
+            return ArgType::NULL_VALUE;
+        case Value::Type::Boolean:
+            return ArgType::BOOLEAN;
+        case Value::Type::Number:
+        case Value::Type::BigInt:
+            return ArgType::NUMBER;
+        case Value::Type::String:
+            return ArgType::STRING;
+        case Value::Type::Object: {
+            Object *obj = value.toObject();
+            if (obj->isFunction()) {
+                return ArgType::FUNCTION;
+            }
+            if (obj->isArray() || obj->isTypedArray() || obj->isArrayBuffer()) {
+                return ArgType::ARRAY;
+            }
+            return ArgType::OBJECT;
+        }
+        default:
+            return 0;
+    }
+}
+} // namespace
+#endif
+
 State::State() = default;
 
 State::~State() {
     SAFE_DEC_REF(_thisObject);
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    if (_lazyArgs != nullptr) {
+        FrameArena::getInstance().pop(_lazyArgs, static_cast<uint32_t>(_args.size()));
+    }
+#endif
 }
 
 State::State(PrivateObjectBase *privateObject)
 : _privateObject(privateObject) {}
 
-State::State(PrivateObjectBase *privateObject, const ValueArray &args)
+State::State(PrivateObjectBase *privateObject, ValueSpan args)
 : _privateObject(privateObject),
-  _args(&args) {
+  _args(args) {
 }
 
-State::State(Object *thisObject, const ValueArray &args)
+State::State(Object *thisObject, ValueSpan args)
 : _thisObject(thisObject),
-  _args(&args) {
+  _args(args) {
     if (_thisObject != nullptr) {
         _thisObject->incRef();
     }
@@ -59,15 +187,26 @@ State::State(Object *thisObject, PrivateObjectBase *privateObject)
     }
 }
 
-State::State(Object *thisObject, PrivateObjectBase *privateObject, const ValueArray &args)
+State::State(Object *thisObject, PrivateObjectBase *privateObject, ValueSpan args)
 : _privateObject(privateObject),
   _thisObject(thisObject),
-  _args(&args) {
+  _args(args) {
     if (_thisObject != nullptr) {
         _thisObject->incRef();
     }
 }
 
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+State::State(Object *thisObject, PrivateObjectBase *privateObject, const v8::FunctionCallbackInfo<v8::Value> &v8args)
+: _privateObject(privateObject),
+  _thisObject(thisObject),
+  _v8args(&v8args) {
+    if (_thisObject != nullptr) {
+        _thisObject->incRef();
+    }
+}
+#endif
+
 void *State::nativeThisObject() const {
     return _privateObject ? _privateObject->getRaw() : nullptr;
 }
@@ -81,14 +220,132 @@ Object *State::thisObject() {
     return _thisObject;
 }
 
-const ValueArray &State::args() const {
-    if (_args != nullptr) {
-        return *(_args);
+ValueSpan State::args() const {
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    if (_v8args != nullptr && _lazyArgs == nullptr && _v8args->Length() > 0) {
+        auto argc = static_cast<uint32_t>(_v8args->Length());
+        _lazyArgs = FrameArena::getInstance().push(argc);
+        internal::jsToSeArgs(*_v8args, _lazyArgs);
+        _args = ValueSpan(_lazyArgs, argc);
     }
-    return EmptyValueArray;
+#endif
+    return _args;
 }
 
 Value &State::rval() {
     return _retVal;
 }
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+uint32_t State::argCount() const {
+    if (_v8args != nullptr) {
+        return static_cast<uint32_t>(_v8args->Length());
+    }
+    return static_cast<uint32_t>(args().size());
+}
+
+ArgTypeList State::argTypes() const {
+    ArgTypeList ret;
+    if (_v8args != nullptr) {
+        const auto count = std::min(static_cast<uint32_t>(_v8args->Length()), ArgTypeList::MAX_ARGS);
+        for (uint32_t i = 0; i < count; ++i) {
+            ret._types[i] = getArgType((*_v8args)[static_cast<int>(i)]);
+        }
+    } else {
+        const auto &values = args();
+        const auto  count  = std::min(static_cast<uint32_t>(values.size()), ArgTypeList::MAX_ARGS);
+        for (uint32_t i = 0; i < count; ++i) {
+            ret._types[i] = getArgType(values[i]);
+        }
+    }
+    return ret;
+}
+
+void State::appendArgToLog(uint32_t index, std::string *out) const {
+    v8::Isolate *        isolate = v8::Isolate::GetCurrent();
+    v8::Local<v8::Value> jsval;
+    if (_v8args != nullptr) {
+        jsval = (*_v8args)[static_cast<int>(index)];
+    } else {
+        const auto &values = args();
+        if (index >= values.size()) {
+            out->append("undefined");
+            return;
+        }
+        if (!values[index].isObject()) {
+            out->append(values[index].toStringForce());
+            return;
+        }
+        jsval = values[index].toObject()->_getJSObject();
+    }
+    appendLogString(isolate, jsval, out);
+}
+
+bool State::argIsInstanceOf(uint32_t index, Class *cls) const {
+    if (cls == nullptr) {
+        return true;
+    }
+
+    v8::Local<v8::Value> jsval;
+    if (_v8args != nullptr) {
+        if (index >= static_cast<uint32_t>(_v8args->Length())) {
+            return true;
+        }
+        jsval = (*_v8args)[static_cast<int>(index)];
+    } else {
+        const auto &values = args();
+        if (index >= values.size() || values[index].isNullOrUndefined()) {
+            return true;
+        }
+        if (!values[index].isObject()) {
+            return false;
+        }
+        jsval = values[index].toObject()->_getJSObject();
+    }
+    return jsval->IsNullOrUndefined() || cls->_hasInstance(jsval);
+}
+
+void State::returnBoolean(bool v) {
+    if (_v8args != nullptr) {
+        _v8args->GetReturnValue().Set(v);
+    } else {
+        _retVal.setBoolean(v);
+    }
+}
+
+void State::returnInt32(int32_t v) {
+    if (_v8args != nullptr) {
+        _v8args->GetReturnValue().Set(v);
+    } else {
+        _retVal.setInt32(v);
+    }
+}
+
+void State::returnUint32(uint32_t v) {
+    if (_v8args != nullptr) {
+        _v8args->GetReturnValue().Set(v);
+    } else {
+        _retVal.setUint32(v);
+    }
+}
+
+void State::returnDouble(double v) {
+    if (_v8args != nullptr) {
+        _v8args->GetReturnValue().Set(v);
+    } else {
+        _retVal.setDouble(v);
+    }
+}
+
+void State::returnString(const std::string &v) {
+    if (_v8args != nullptr) {
+        v8::MaybeLocal<v8::String> str = v8::String::NewFromUtf8(_v8args->GetIsolate(), v.data(), v8::NewStringType::kNormal, static_cast<int>(v.length()));
+        if (!str.IsEmpty()) {
+            _v8args->GetReturnValue().Set(str.ToLocalChecked());
+        }
+    } else {
+        _retVal.setString(v);
+    }
+}
+#endif
 } // namespace se
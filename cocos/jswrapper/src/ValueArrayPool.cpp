@@ -1,67 +0,0 @@
-/****************************************************************************
- Copyright (c) 2016 Chukong Technologies Inc.
- Copyright (c) 2017-2021 Xiamen Yaji Software Co., Ltd.
-
- http://www.cocos.com
-
- Permission is hereby granted, free of charge, to any person obtaining a copy
- of this software and associated engine source code (the "Software"), a limited,
- worldwide, royalty-free, non-assignable, revocable and non-exclusive license
- to use Cocos Creator solely to develop games on your target platforms. You shall
- not use Cocos Creator software for developing other software or tools that's
- used for developing games. You are not granted to publish, distribute,
- sublicense, and/or sell copies of Cocos Creator.
-
- The software or tools in this License Agreement are licensed, not sold.
- Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
-
- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- THE SOFTWARE.
-****************************************************************************/
-
-#include "ValueArrayPool.h"
-#include <cassert>
-#include "config.h"
-
-namespace se {
-
-ValueArrayPool gValueArrayPool;
-
-#define SE_DEFAULT_MAX_DEPTH (5)
-
-ValueArrayPool::ValueArrayPool() {
-    _pools.resize(SE_DEFAULT_MAX_DEPTH);
-    for (uint32_t i = 0; i < SE_DEFAULT_MAX_DEPTH; ++i) {
-        initPool(i);
-    }
-}
-
-ValueArray &ValueArrayPool::get(uint32_t argc) {
-    if (SE_UNLIKELY(_depth >= _pools.size())) {
-        auto *ptr = _pools.data();
-        _pools.resize(_depth + 1);
-        assert(_pools.data() == ptr);
-        initPool(_depth);
-    }
-
-    assert(argc <= MAX_ARGS);
-    auto &ret = _pools[_depth][argc];
-    assert(ret.size() == argc);
-    return ret;
-}
-
-void ValueArrayPool::initPool(uint32_t index) {
-    auto &   pool = _pools[index];
-    uint32_t i    = 0;
-    for (auto &arr : pool) {
-        arr.resize(i);
-        ++i;
-    }
-}
-
-} // namespace se
@@ -389,7 +389,7 @@ bool Object::defineOwnProperty(const char *name, const se::Value &value, bool wr
     return JS_DefineProperty(__cx, jsObj, name, jsVal, attrs);
 }
 
-bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = nullptr*/) {
+bool Object::call(ValueSpan args, Object *thisObject, Value *rval /* = nullptr*/) {
     assert(isFunction());
 
     JS::RootedValueVector jsarr(__cx);
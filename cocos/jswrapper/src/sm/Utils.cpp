@@ -64,13 +64,13 @@ std::string jsToStdString(JSContext *cx, JS::HandleString jsStr) {
     return ret;
 }
 
-void jsToSeArgs(JSContext *cx, int argc, const JS::CallArgs &argv, ValueArray &outArr) {
+void jsToSeArgs(JSContext *cx, int argc, const JS::CallArgs &argv, Value *outArr) {
     for (int i = 0; i < argc; ++i) {
         jsToSeValue(cx, argv[i], &outArr[i]);
     }
 }
 
-void seToJsArgs(JSContext *cx, const ValueArray &args, JS::RootedValueVector *outArr) {
+void seToJsArgs(JSContext *cx, ValueSpan args, JS::RootedValueVector *outArr) {
     for (const auto &arg : args) {
         JS::RootedValue v(cx);
         seToJsValue(cx, arg, &v);
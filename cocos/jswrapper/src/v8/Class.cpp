@@ -25,6 +25,7 @@
 ****************************************************************************/
 
 #include "Class.h"
+#include <algorithm>
 #include <initializer_list>
 #include "Value.h"
 #include "base/Macros.h"
@@ -51,6 +52,49 @@ void invalidConstructor(const v8::FunctionCallbackInfo<v8::Value> &args) {
     SE_ASSERT(false, "%s 's constructor is not public!", *strConstructorName); // NOLINT(misc-static-assert)
 }
 
+struct LazyClassEntry {
+    std::string              name;
+    Object *                 ns{nullptr};
+    Class::LazyInstallFunc   installFunc{nullptr};
+    v8::Global<v8::Function> ctor;
+    bool                     installing{false};
+    bool                     installed{false};
+};
+
+v8::Global<v8::String> __ctorHookName; // NOLINT
+
+std::vector<LazyClassEntry *> __lazyClasses;               // NOLINT
+LazyClassEntry *              __installingLazyClass = nullptr; // NOLINT
+
+// V8 replaces the lazy data property with the returned value, so the class must not
+// be set to ns by Class::install while it's installed from here.
+void lazyClassGetter(v8::Local<v8::Name> /*property*/, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    auto *entry = static_cast<LazyClassEntry *>(info.Data().As<v8::External>()->Value());
+    if (entry->installing) {
+        if (!entry->ctor.IsEmpty()) {
+            info.GetReturnValue().Set(entry->ctor.Get(info.GetIsolate()));
+        }
+        return;
+    }
+
+    if (!entry->installed) {
+        LazyClassEntry *prevEntry = __installingLazyClass;
+        __installingLazyClass     = entry;
+        entry->installing         = true;
+        entry->installed          = entry->installFunc(entry->ns);
+        entry->installing         = false;
+        __installingLazyClass     = prevEntry;
+        if (!entry->installed) {
+            SE_LOGE("Failed to install class %s\n", entry->name.c_str());
+        }
+    }
+
+    if (!entry->ctor.IsEmpty()) {
+        info.GetReturnValue().Set(entry->ctor.Get(info.GetIsolate()));
+        entry->ctor.Reset();
+    }
+}
+
 } // namespace
 
 Class::Class()
@@ -128,6 +172,14 @@ void Class::cleanup() {
         cls->destroy();
     }
 
+    __ctorHookName.Reset();
+
+    for (auto *entry : __lazyClasses) {
+        SAFE_DEC_REF(entry->ns);
+        delete entry;
+    }
+    __lazyClasses.clear();
+
     se::ScriptEngine::getInstance()->addAfterCleanupHook([]() {
         for (auto *cls : __allClasses) {
             delete cls;
@@ -161,9 +213,14 @@ bool Class::install() {
         return false;
     }
 
-    v8::Maybe<bool> result = _parent->_getJSObject()->Set(context, name.ToLocalChecked(), ctorChecked);
-    if (result.IsNothing()) {
-        return false;
+    if (__installingLazyClass != nullptr && __installingLazyClass->name == _name && __installingLazyClass->ns->_getJSObject() == _parent->_getJSObject()) {
+        // Returned by the lazy getter instead.
+        __installingLazyClass->ctor.Reset(__isolate, ctorChecked);
+    } else {
+        v8::Maybe<bool> result = _parent->_getJSObject()->Set(context, name.ToLocalChecked(), ctorChecked);
+        if (result.IsNothing()) {
+            return false;
+        }
     }
 
     v8::MaybeLocal<v8::String> prototypeName = v8::String::NewFromUtf8(__isolate, "prototype", v8::NewStringType::kNormal);
@@ -210,6 +267,15 @@ bool Class::defineProperty(const std::initializer_list<const char *> &names, v8:
     return ret;
 }
 
+bool Class::_defineField(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter) { // NOLINT(readability-identifier-naming)
+    v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+    if (jsName.IsEmpty()) {
+        return false;
+    }
+    _ctorTemplate.Get(__isolate)->PrototypeTemplate()->SetAccessor(jsName.ToLocalChecked(), getter, setter);
+    return true;
+}
+
 bool Class::defineStaticFunction(const char *name, v8::FunctionCallback func) {
     v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (jsName.IsEmpty()) {
@@ -253,6 +319,77 @@ v8::Local<v8::Object> Class::_createJSObjectWithClass(Class *cls) { //NOLINT
     return ret.ToLocalChecked();
 }
 
+/* static */
+bool Class::defineLazy(Object *ns, const char *name, LazyInstallFunc installFunc) {
+    assert(ns != nullptr && installFunc != nullptr);
+    v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+    if (jsName.IsEmpty()) {
+        return false;
+    }
+
+    auto *entry        = new LazyClassEntry();
+    entry->name        = name;
+    entry->ns          = ns;
+    entry->installFunc = installFunc;
+
+    v8::Local<v8::Context> context = __isolate->GetCurrentContext();
+    v8::Maybe<bool>        result  = ns->_getJSObject()->SetLazyDataProperty(context, jsName.ToLocalChecked(), lazyClassGetter, v8::External::New(__isolate, entry));
+    if (result.IsNothing() || !result.FromJust()) {
+        delete entry;
+        return false;
+    }
+
+    ns->incRef();
+    __lazyClasses.push_back(entry);
+    return true;
+}
+
+/* static */
+bool Class::installLazy(LazyInstallFunc installFunc) {
+    auto iter = std::find_if(__lazyClasses.begin(), __lazyClasses.end(), [installFunc](LazyClassEntry *entry) {
+        return entry->installFunc == installFunc;
+    });
+    if (iter == __lazyClasses.end()) {
+        return false;
+    }
+
+    LazyClassEntry *entry = *iter;
+    if (!entry->installed && !entry->installing) {
+        // Installed as a normal class, setting ns[name] replaces the lazy data property.
+        entry->installing = true;
+        entry->installed  = entry->installFunc(entry->ns);
+        entry->installing = false;
+    }
+    return entry->installed;
+}
+
+bool Class::createObjects(size_t count, Object **out) {
+    v8::HandleScope               hs(__isolate);
+    v8::Local<v8::Context>        context          = __isolate->GetCurrentContext();
+    v8::Local<v8::ObjectTemplate> instanceTemplate = _ctorTemplate.Get(__isolate)->InstanceTemplate();
+    for (size_t i = 0; i < count; ++i) {
+        v8::MaybeLocal<v8::Object> jsobj = instanceTemplate->NewInstance(context);
+        out[i]                           = jsobj.IsEmpty() ? nullptr : Object::_createJSObject(this, jsobj.ToLocalChecked());
+        if (out[i] == nullptr) {
+            for (size_t j = 0; j < i; ++j) {
+                out[j]->decRef();
+                out[j] = nullptr;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Class::_hasCtorHook(v8::Local<v8::Object> thisObj) { //NOLINT
+    // Not cached since scripts may add or remove `_ctor` of the prototype at any time, the internalized name keeps the lookup fast.
+    if (__ctorHookName.IsEmpty()) {
+        __ctorHookName.Reset(__isolate, v8::String::NewFromUtf8Literal(__isolate, "_ctor", v8::NewStringType::kInternalized));
+    }
+    v8::MaybeLocal<v8::Value> hook = thisObj->Get(__isolate->GetCurrentContext(), __ctorHookName.Get(__isolate));
+    return !hook.IsEmpty() && hook.ToLocalChecked()->IsFunction();
+}
+
 Object *Class::getProto() const {
     return _proto;
 }
@@ -261,6 +398,11 @@ V8FinalizeFunc Class::_getFinalizeFunction() const { //NOLINT
     return _finalizeFunc;
 }
 
+bool Class::_hasInstance(v8::Local<v8::Value> value) const { //NOLINT
+    // Instances of subclasses match too since their templates inherit this one.
+    return !_ctorTemplate.IsEmpty() && _ctorTemplate.Get(__isolate)->HasInstance(value);
+}
+
 /* static */
 void Class::setIsolate(v8::Isolate *isolate) {
     __isolate = isolate;
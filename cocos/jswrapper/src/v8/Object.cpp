@@ -29,6 +29,7 @@
 
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
     #include "../MappingUtils.h"
+    #include "base/Data.h"
     #include "Class.h"
     #include "ScriptEngine.h"
     #include "Utils.h"
@@ -49,11 +50,93 @@ v8::Isolate *__isolate = nullptr; //NOLINT
     #if CC_DEBUG_JS_OBJECT_ID && CC_DEBUG
 uint32_t nativeObjectId = 0;
     #endif
+
+bool isTypedArrayTypeSupported(Object::TypedArrayType type) {
+    if (type == Object::TypedArrayType::NONE) {
+        SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
+        return false;
+    }
+
+    if (type == Object::TypedArrayType::UINT8_CLAMPED) {
+        SE_LOGE("Doesn't support to create Uint8ClampedArray with Object::createTypedArray API!");
+        return false;
+    }
+    return true;
+}
+
+// Backs an ArrayBuffer with a malloc'd block whose content is left uninitialized, returns an empty handle if allocation fails.
+v8::Local<v8::ArrayBuffer> newUninitializedArrayBuffer(size_t byteLength, uint8_t **outData) {
+    void *contents = byteLength > 0 ? malloc(byteLength) : nullptr;
+    *outData       = static_cast<uint8_t *>(contents);
+    if (byteLength > 0 && contents == nullptr) {
+        SE_LOGE("Failed to allocate ArrayBuffer of %zu bytes\n", byteLength);
+        return {};
+    }
+
+    std::shared_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(
+        contents, byteLength, [](void *data, size_t /*byteLength*/, void * /*userData*/) { free(data); }, nullptr);
+    return v8::ArrayBuffer::New(__isolate, backingStore);
+}
+
+v8::Local<v8::Object> newTypedArray(Object::TypedArrayType type, v8::Local<v8::ArrayBuffer> buffer, size_t byteLength) {
+    v8::Local<v8::Object> arr;
+    switch (type) {
+        case Object::TypedArrayType::INT8:
+            arr = v8::Int8Array::New(buffer, 0, byteLength);
+            break;
+        case Object::TypedArrayType::INT16:
+            arr = v8::Int16Array::New(buffer, 0, byteLength / 2);
+            break;
+        case Object::TypedArrayType::INT32:
+            arr = v8::Int32Array::New(buffer, 0, byteLength / 4);
+            break;
+        case Object::TypedArrayType::UINT8:
+            arr = v8::Uint8Array::New(buffer, 0, byteLength);
+            break;
+        case Object::TypedArrayType::UINT16:
+            arr = v8::Uint16Array::New(buffer, 0, byteLength / 2);
+            break;
+        case Object::TypedArrayType::UINT32:
+            arr = v8::Uint32Array::New(buffer, 0, byteLength / 4);
+            break;
+        case Object::TypedArrayType::FLOAT32:
+            arr = v8::Float32Array::New(buffer, 0, byteLength / 4);
+            break;
+        case Object::TypedArrayType::FLOAT64:
+            arr = v8::Float64Array::New(buffer, 0, byteLength / 8);
+            break;
+        default:
+            assert(false); // Should never go here.
+            break;
+    }
+    return arr;
+}
+
+// Owns the JSON text, V8 keeps external strings until they are garbage collected, e.g. the debugger may hold the source after parsing fails.
+class ExternalJSONSource : public v8::String::ExternalOneByteStringResource {
+public:
+    ExternalJSONSource(cc::Data &&data, size_t offset) : _data(std::move(data)), _offset(offset) {}
+    const char *data() const override { return reinterpret_cast<const char *>(_data.getBytes()) + _offset; }
+    size_t      length() const override { return static_cast<size_t>(_data.getSize()) - _offset; }
+
+private:
+    cc::Data _data;
+    size_t   _offset;
+};
+
+bool isASCII(const char *data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (static_cast<uint8_t>(data[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace
 
 Object::Object() { //NOLINT
     #if JSB_TRACK_OBJECT_CREATION
-    _objectCreationStackFrame = se::ScriptEngine::getInstance()->getCurrentStackTrace();
+    _objectCreationStackFrame = StackTrace::capture();
     #endif
 }
 
@@ -158,6 +241,15 @@ Object *Object::createPlainObject() {
     return obj;
 }
 
+Object *Object::createPromiseResolver(Value *promise) {
+    v8::Local<v8::Promise::Resolver> resolver;
+    if (!v8::Promise::Resolver::New(__isolate->GetCurrentContext()).ToLocal(&resolver)) {
+        return nullptr;
+    }
+    internal::jsToSeValue(__isolate, resolver->GetPromise(), promise);
+    return _createJSObject(nullptr, resolver);
+}
+
 Object *Object::getObjectWithPtr(void *ptr) {
     Object *obj  = nullptr;
     auto    iter = NativePtrToObjectMap::find(ptr);
@@ -189,12 +281,32 @@ Object *Object::createArrayObject(size_t length) {
     return obj;
 }
 
+Object *Object::createArrayObject(Object *const *elements, size_t count) {
+    std::vector<v8::Local<v8::Value>> jsElements(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (elements[i] != nullptr) {
+            jsElements[i] = elements[i]->_getJSObject();
+        } else {
+            jsElements[i] = v8::Null(__isolate);
+        }
+    }
+    v8::Local<v8::Array> jsobj = v8::Array::New(__isolate, jsElements.data(), count);
+    Object *             obj   = Object::_createJSObject(nullptr, jsobj);
+    return obj;
+}
+
 Object *Object::createArrayBufferObject(const void *data, size_t byteLength) {
-    v8::Local<v8::ArrayBuffer> jsobj = v8::ArrayBuffer::New(__isolate, byteLength);
+    v8::Local<v8::ArrayBuffer> jsobj;
     if (data) {
-        memcpy(jsobj->GetBackingStore()->Data(), data, byteLength);
+        uint8_t *bytes = nullptr;
+        jsobj          = newUninitializedArrayBuffer(byteLength, &bytes);
+        if (jsobj.IsEmpty()) {
+            return nullptr;
+        }
+        memcpy(bytes, data, byteLength);
     } else {
-        memset(jsobj->GetBackingStore()->Data(), 0, byteLength);
+        // ArrayBuffer::New returns zero-initialized memory.
+        jsobj = v8::ArrayBuffer::New(__isolate, byteLength);
     }
     Object *obj = Object::_createJSObject(nullptr, jsobj);
     return obj;
@@ -212,57 +324,63 @@ Object *Object::createExternalArrayBufferObject(void* contents, size_t byteLengt
     return obj;
 }
 
-Object *Object::createTypedArray(TypedArrayType type, const void *data, size_t byteLength) {
-    if (type == TypedArrayType::NONE) {
-        SE_LOGE("Don't pass se::Object::TypedArrayType::NONE to createTypedArray API!");
-        return nullptr;
-    }
+/* static */
+Object *Object::createArrayBufferFromData(cc::Data &&data) {
+    ssize_t size  = 0;
+    auto *  bytes = data.takeBuffer(&size);
+    if (bytes == nullptr) {
+        return createArrayBufferObject(nullptr, 0);
+    }
+    return createExternalArrayBufferObject(
+        bytes, static_cast<size_t>(size), [](void *contents, size_t /*byteLength*/, void * /*userData*/) { free(contents); });
+}
 
-    if (type == TypedArrayType::UINT8_CLAMPED) {
-        SE_LOGE("Doesn't support to create Uint8ClampedArray with Object::createTypedArray API!");
+Object *Object::createTypedArray(TypedArrayType type, const void *data, size_t byteLength) {
+    if (!isTypedArrayTypeSupported(type)) {
         return nullptr;
     }
 
-    v8::Local<v8::ArrayBuffer> jsobj = v8::ArrayBuffer::New(__isolate, byteLength);
-    //If data has content,then will copy data into buffer,or will only clear buffer.
+    v8::Local<v8::ArrayBuffer> jsobj;
     if (data) {
-        memcpy(jsobj->GetBackingStore()->Data(), data, byteLength);
+        // Copy into an uninitialized buffer, ArrayBuffer::New would zero the memory before the copy.
+        uint8_t *bytes = nullptr;
+        jsobj          = newUninitializedArrayBuffer(byteLength, &bytes);
+        if (jsobj.IsEmpty()) {
+            return nullptr;
+        }
+        memcpy(bytes, data, byteLength);
     } else {
-        memset(jsobj->GetBackingStore()->Data(), 0, byteLength);
+        // ArrayBuffer::New returns zero-initialized memory.
+        jsobj = v8::ArrayBuffer::New(__isolate, byteLength);
     }
 
-    v8::Local<v8::Object> arr;
-    switch (type) {
-        case TypedArrayType::INT8:
-            arr = v8::Int8Array::New(jsobj, 0, byteLength);
-            break;
-        case TypedArrayType::INT16:
-            arr = v8::Int16Array::New(jsobj, 0, byteLength / 2);
-            break;
-        case TypedArrayType::INT32:
-            arr = v8::Int32Array::New(jsobj, 0, byteLength / 4);
-            break;
-        case TypedArrayType::UINT8:
-            arr = v8::Uint8Array::New(jsobj, 0, byteLength);
-            break;
-        case TypedArrayType::UINT16:
-            arr = v8::Uint16Array::New(jsobj, 0, byteLength / 2);
-            break;
-        case TypedArrayType::UINT32:
-            arr = v8::Uint32Array::New(jsobj, 0, byteLength / 4);
-            break;
-        case TypedArrayType::FLOAT32:
-            arr = v8::Float32Array::New(jsobj, 0, byteLength / 4);
-            break;
-        case TypedArrayType::FLOAT64:
-            arr = v8::Float64Array::New(jsobj, 0, byteLength / 8);
-            break;
-        default:
-            assert(false); // Should never go here.
-            break;
+    Object *obj = Object::_createJSObject(nullptr, newTypedArray(type, jsobj, byteLength));
+    return obj;
+}
+
+/* static */
+Object *Object::createTypedArrayUninitialized(TypedArrayType type, size_t byteLength, uint8_t **outData) {
+    assert(outData != nullptr);
+    *outData = nullptr;
+    if (!isTypedArrayTypeSupported(type)) {
+        return nullptr;
     }
 
-    Object *obj = Object::_createJSObject(nullptr, arr);
+    v8::Local<v8::ArrayBuffer> jsobj = newUninitializedArrayBuffer(byteLength, outData);
+    if (jsobj.IsEmpty()) {
+        return nullptr;
+    }
+    Object *obj = Object::_createJSObject(nullptr, newTypedArray(type, jsobj, byteLength));
+    return obj;
+}
+
+/* static */
+Object *Object::createTypedArrayUninitialized(TypedArrayType type, size_t byteLength, const TypedArrayFillFunc &fillFunc) {
+    uint8_t *bytes = nullptr;
+    Object * obj   = createTypedArrayUninitialized(type, byteLength, &bytes);
+    if (obj != nullptr && fillFunc != nullptr) {
+        fillFunc(bytes, byteLength);
+    }
     return obj;
 }
 
@@ -343,6 +461,40 @@ Object *Object::createJSONObject(const std::string &jsonStr) {
     return Object::_createJSObject(nullptr, jsobj);
 }
 
+Object *Object::createJSONObjectFromBuffer(cc::Data &&buffer) {
+    const char *data   = reinterpret_cast<const char *>(buffer.getBytes());
+    auto        length = static_cast<size_t>(buffer.getSize());
+    size_t      offset = 0;
+    if (data == nullptr) {
+        return nullptr;
+    }
+    // Skip UTF-8 BOM
+    if (length >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        offset = 3;
+        data += 3;
+        length -= 3;
+    }
+
+    v8::MaybeLocal<v8::String> source;
+    if (isASCII(data, length)) {
+        // ASCII is a subset of Latin-1, the buffer is moved into the string and parsed in place.
+        source = v8::String::NewExternalOneByte(__isolate, new ExternalJSONSource(std::move(buffer), offset));
+    } else {
+        source = v8::String::NewFromUtf8(__isolate, data, v8::NewStringType::kNormal, static_cast<int>(length));
+    }
+    if (source.IsEmpty()) {
+        return nullptr;
+    }
+
+    v8::MaybeLocal<v8::Value> ret = v8::JSON::Parse(__isolate->GetCurrentContext(), source.ToLocalChecked());
+    if (ret.IsEmpty() || !ret.ToLocalChecked()->IsObject()) {
+        return nullptr;
+    }
+
+    v8::Local<v8::Object> jsobj = v8::Local<v8::Object>::Cast(ret.ToLocalChecked());
+    return Object::_createJSObject(nullptr, jsobj);
+}
+
 bool Object::init(Class *cls, v8::Local<v8::Object> obj) {
     _cls = cls;
 
@@ -561,6 +713,30 @@ bool Object::getArrayBufferData(uint8_t **ptr, size_t *length) const {
     return true;
 }
 
+bool Object::getBackingStoreData(cc::Data *data) const {
+    assert(data != nullptr);
+    v8::Local<v8::Object>             obj = const_cast<Object *>(this)->_obj.handle(__isolate);
+    std::shared_ptr<v8::BackingStore> backingStore;
+    size_t                            offset = 0;
+    size_t                            length = 0;
+    if (obj->IsArrayBuffer()) {
+        backingStore = v8::Local<v8::ArrayBuffer>::Cast(obj)->GetBackingStore();
+        length       = backingStore->ByteLength();
+    } else if (obj->IsArrayBufferView()) {
+        v8::Local<v8::ArrayBufferView> view = v8::Local<v8::ArrayBufferView>::Cast(obj);
+        backingStore                        = view->Buffer()->GetBackingStore();
+        offset                              = view->ByteOffset();
+        length                              = view->ByteLength();
+    } else {
+        SE_LOGE("Object::getBackingStoreData: object is neither an ArrayBuffer nor a TypedArray!");
+        return false;
+    }
+
+    auto *bytes = static_cast<unsigned char *>(backingStore->Data()) + offset;
+    data->setView(bytes, static_cast<ssize_t>(length), std::move(backingStore));
+    return true;
+}
+
 void Object::setPrivateObject(PrivateObjectBase *data) {
     assert(_privateObject == nullptr);
     #if CC_DEBUG
@@ -570,7 +746,7 @@ void Object::setPrivateObject(PrivateObjectBase *data) {
         auto *pri = it->second->getPrivateObject();
         SE_LOGE("Already exists object %s/[%s], trying to add %s/[%s]\n", pri->getName(), typeid(*pri).name(), data->getName(), typeid(*data).name());
         #if JSB_TRACK_OBJECT_CREATION
-        SE_LOGE(" previous object created at %s\n", it->second->_objectCreationStackFrame.c_str());
+        SE_LOGE(" previous object created at %s\n", it->second->_objectCreationStackFrame.toString().c_str());
         #endif
         assert(false);
     }
@@ -608,11 +784,7 @@ ObjectWrap &Object::_getWrap() { // NOLINT(readability-identifier-naming)
     return _obj;
 }
 
-bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = nullptr*/) {
-    if (_obj.persistent().IsEmpty()) {
-        SE_LOGD("Function object is released!\n");
-        return false;
-    }
+bool Object::call(ValueSpan args, Object *thisObject, Value *rval /* = nullptr*/) {
     size_t argc = args.size();
 
     std::array<v8::Local<v8::Value>, JSB_FUNC_DEFAULT_MAX_ARG_COUNT> argv;
@@ -626,6 +798,35 @@ bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = n
     }
 
     internal::seToJsArgs(__isolate, args, pArgv);
+    return _callWithArgv(thisObject, argc, pArgv, rval);
+}
+
+bool Object::resolvePromise(const Value &value) {
+    // V8 implements a resolver as the promise object itself, so the resolver is type-checked as a promise.
+    v8::Local<v8::Object> obj = _obj.handle(__isolate);
+    if (!obj->IsPromise()) {
+        return false;
+    }
+    v8::Local<v8::Value> jsval;
+    internal::seToJsValue(__isolate, value, &jsval);
+    return v8::Local<v8::Promise::Resolver>::Cast(obj)->Resolve(__isolate->GetCurrentContext(), jsval).FromMaybe(false);
+}
+
+bool Object::rejectPromise(const Value &reason) {
+    v8::Local<v8::Object> obj = _obj.handle(__isolate);
+    if (!obj->IsPromise()) {
+        return false;
+    }
+    v8::Local<v8::Value> jsval;
+    internal::seToJsValue(__isolate, reason, &jsval);
+    return v8::Local<v8::Promise::Resolver>::Cast(obj)->Reject(__isolate->GetCurrentContext(), jsval).FromMaybe(false);
+}
+
+bool Object::_callWithArgv(Object *thisObject, size_t argc, v8::Local<v8::Value> *argv, Value *rval) {
+    if (_obj.persistent().IsEmpty()) {
+        SE_LOGD("Function object is released!\n");
+        return false;
+    }
 
     v8::Local<v8::Object> thiz = v8::Local<v8::Object>::Cast(v8::Undefined(__isolate));
     if (thisObject != nullptr) {
@@ -637,7 +838,7 @@ bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = n
     }
 
     for (size_t i = 0; i < argc; ++i) {
-        if (pArgv[i].IsEmpty()) {
+        if (argv[i].IsEmpty()) {
             SE_LOGD("%s argv[%d] is released!\n", __FUNCTION__, (int)i);
             return false;
         }
@@ -647,7 +848,7 @@ bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = n
     #if CC_DEBUG
     v8::TryCatch tryCatch(__isolate);
     #endif
-    v8::MaybeLocal<v8::Value> result = _obj.handle(__isolate)->CallAsFunction(context, thiz, static_cast<int>(argc), pArgv);
+    v8::MaybeLocal<v8::Value> result = _obj.handle(__isolate)->CallAsFunction(context, thiz, static_cast<int>(argc), argv);
 
     #if CC_DEBUG
     if (tryCatch.HasCaught()) {
@@ -872,6 +1073,28 @@ std::string Object::toString() const {
     return ret;
 }
 
+bool Object::toJSON(std::string *json) const {
+    assert(json != nullptr);
+    // Cyclic references and BigInt values throw, the exception is logged instead of being left pending on the isolate.
+    v8::TryCatch               tryCatch(__isolate);
+    v8::MaybeLocal<v8::String> result = v8::JSON::Stringify(__isolate->GetCurrentContext(), const_cast<Object *>(this)->_obj.handle(__isolate));
+    if (result.IsEmpty()) {
+        if (tryCatch.HasCaught() && !tryCatch.Message().IsEmpty()) {
+            v8::String::Utf8Value message(__isolate, tryCatch.Message()->Get());
+            SE_LOGE("Object::toJSON, %s\n", *message != nullptr ? *message : "");
+        }
+        json->clear();
+        return false;
+    }
+
+    // Resizing keeps the capacity, so the same string can be reused as the output buffer.
+    v8::Local<v8::String> str    = result.ToLocalChecked();
+    const int             length = str->Utf8Length(__isolate);
+    json->resize(length);
+    str->WriteUtf8(__isolate, &(*json)[0], length, nullptr, v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+    return true;
+}
+
 std::string Object::toStringExt() const {
     if (isFunction()) return "[function]";
     if (isArray()) return "[array]";
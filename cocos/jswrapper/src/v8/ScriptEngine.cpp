@@ -27,6 +27,7 @@
 
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
 
+    #include "../FrameArena.h"
     #include "../MappingUtils.h"
     #include "../State.h"
     #include "Class.h"
@@ -44,10 +45,12 @@
     #endif
 
     #include <array>
+    #include <condition_variable>
+    #include <mutex>
+    #include <string_view>
 
     #define EXPOSE_GC "__jsb_gc__"
 
-const unsigned int JSB_STACK_FRAME_LIMIT = 20;
 
     #ifdef CC_DEBUG
 unsigned int                    jsbInvocationCount = 0;
@@ -73,44 +76,67 @@ void seForceGC(const v8::FunctionCallbackInfo<v8::Value> & /*info*/) {
     ScriptEngine::getInstance()->garbageCollect();
 }
 
-std::string stackTraceToString(v8::Local<v8::StackTrace> stack) {
-    std::string stackStr;
-    if (stack.IsEmpty()) {
-        return stackStr;
-    }
+std::string formatPromiseRejection(v8::Isolate *isolate, v8::Local<v8::Promise> promise, v8::Local<v8::Value> value, const StackTrace &stack) {
+    std::stringstream ss;
+    if (!value.IsEmpty()) {
+        // prepend error object to stack message
+        v8::MaybeLocal<v8::String> maybeStr = value->ToString(isolate->GetCurrentContext());
+        v8::Local<v8::String>      str      = maybeStr.IsEmpty() ? v8::String::NewFromUtf8(isolate, "[empty string]").ToLocalChecked() : maybeStr.ToLocalChecked();
+        v8::String::Utf8Value      valueUtf8(isolate, str);
+        auto *                     strp = *valueUtf8;
+        if (strp == nullptr) {
+            ss << "value: null" << std::endl;
+            auto                  tn = value->TypeOf(isolate);
+            v8::String::Utf8Value tnUtf8(isolate, tn);
+            strp = *tnUtf8;
+            if (strp) {
+                ss << " type: " << strp << std::endl;
+            }
+            if (value->IsObject()) {
+                v8::MaybeLocal<v8::String> json = v8::JSON::Stringify(isolate->GetCurrentContext(), value);
+                if (!json.IsEmpty()) {
+                    v8::String::Utf8Value jsonStr(isolate, json.ToLocalChecked());
+                    strp = *jsonStr;
+                    if (strp) {
+                        ss << " obj: " << strp << std::endl;
+                    } else {
+                        ss << " obj: null" << std::endl;
+                    }
+                } else {
+                    v8::Local<v8::Object> obj       = value->ToObject(isolate->GetCurrentContext()).ToLocalChecked();
+                    v8::Local<v8::Array>  attrNames = obj->GetOwnPropertyNames(isolate->GetCurrentContext()).ToLocalChecked();
 
-    char tmp[100] = {0};
-    for (int i = 0, e = stack->GetFrameCount(); i < e; ++i) {
-        v8::Local<v8::StackFrame> frame  = stack->GetFrame(v8::Isolate::GetCurrent(), i);
-        v8::Local<v8::String>     script = frame->GetScriptName();
-        std::string               scriptName;
-        if (!script.IsEmpty()) {
-            scriptName = *v8::String::Utf8Value(v8::Isolate::GetCurrent(), script);
-        }
+                    if (!attrNames.IsEmpty()) {
+                        uint32_t size = attrNames->Length();
 
-        v8::Local<v8::String> func = frame->GetFunctionName();
-        std::string           funcName;
-        if (!func.IsEmpty()) {
-            funcName = *v8::String::Utf8Value(v8::Isolate::GetCurrent(), func);
-        }
+                        for (uint32_t i = 0; i < size; i++) {
+                            v8::Local<v8::String> attrName = attrNames->Get(isolate->GetCurrentContext(), i)
+                                                                 .ToLocalChecked()
+                                                                 ->ToString(isolate->GetCurrentContext())
+                                                                 .ToLocalChecked();
+                            v8::String::Utf8Value attrUtf8(isolate, attrName);
+                            strp = *attrUtf8;
+                            ss << " obj.property " << strp << std::endl;
+                        }
+                        ss << " obj: JSON.parse failed!" << std::endl;
+                    }
+                }
+            }
 
-        stackStr += " - [";
-        snprintf(tmp, sizeof(tmp), "%d", i);
-        stackStr += tmp;
-        stackStr += "]";
-        stackStr += (funcName.empty() ? "anonymous" : funcName.c_str());
-        stackStr += "@";
-        stackStr += (scriptName.empty() ? "(no filename)" : scriptName.c_str());
-        stackStr += ":";
-        snprintf(tmp, sizeof(tmp), "%d", frame->GetLineNumber());
-        stackStr += tmp;
+        } else {
+            ss << *valueUtf8 << std::endl;
+        }
 
-        if (i < (e - 1)) {
-            stackStr += "\n";
+        v8::String::Utf8Value valuePromiseConstructor(isolate, promise->GetConstructorName());
+        strp = *valuePromiseConstructor;
+        if (strp) {
+            ss << "PromiseConstructor " << strp;
         }
     }
 
-    return stackStr;
+    ss << "stacktrace: " << std::endl;
+    ss << stack.toString() << std::endl;
+    return ss.str();
 }
 
 se::Value oldConsoleLog;
@@ -120,75 +146,140 @@ se::Value oldConsoleWarn;
 se::Value oldConsoleError;
 se::Value oldConsoleAssert;
 
-bool jsbConsoleFormatLog(State &state, const char *prefix, int msgIndex = 0) {
-    if (msgIndex < 0) {
-        return false;
+// Fix the source url is too long displayed in Chrome debugger.
+std::string getSourceUrl(const char *fileName) {
+    std::string              sourceUrl  = fileName;
+    static const std::string PREFIX_KEY = "/temp/quick-scripts/";
+    size_t                   prefixPos  = sourceUrl.find(PREFIX_KEY);
+    if (prefixPos != std::string::npos) {
+        sourceUrl = sourceUrl.substr(prefixPos + PREFIX_KEY.length());
     }
+    return sourceUrl;
+}
 
-    const auto &args = state.args();
-    int         argc = static_cast<int>(args.size());
-    if ((argc - msgIndex) == 1) {
-        std::string msg = args[msgIndex].toStringForce();
-        SE_LOGD("JS: %s%s\n", prefix, msg.c_str());
-    } else if (argc > 1) {
-        std::string msg = args[msgIndex].toStringForce();
-        size_t      pos;
-        for (int i = (msgIndex + 1); i < argc; ++i) {
-            pos = msg.find('%');
-            if (pos != std::string::npos && pos != (msg.length() - 1) && (msg[pos + 1] == 'd' || msg[pos + 1] == 's' || msg[pos + 1] == 'f')) {
-                msg.replace(pos, 2, args[i].toStringForce());
-            } else {
-                msg += " " + args[i].toStringForce();
-            }
+// Provides the whole script to V8 at once, it's read in the same worker thread before streaming starts.
+class ScriptSourceStream final : public v8::ScriptCompiler::ExternalSourceStream {
+public:
+    explicit ScriptSourceStream(const std::string *source) : _source(source) {}
+
+    size_t GetMoreData(const uint8_t **src) override {
+        if (_isConsumed || _source->empty()) {
+            return 0;
         }
+        _isConsumed = true;
+        auto *data  = new uint8_t[_source->length()]; // V8 takes the ownership.
+        memcpy(data, _source->data(), _source->length());
+        *src = data;
+        return _source->length();
+    }
+
+private:
+    const std::string *_source;
+    bool               _isConsumed{false};
+};
+
+struct StreamingScript {
+    std::string                                              path;
+    std::string                                              source;
+    std::unique_ptr<v8::ScriptCompiler::StreamedSource>      streamedSource;
+    std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> task;
+    std::mutex                                               mutex;
+    std::condition_variable                                  cond;
+    bool                                                     isDone{false};
+};
+
+// Reused by every console call to avoid allocations, arguments are written into them directly.
+thread_local std::string gConsoleBuffer;
+thread_local std::string gConsoleFormat;
+thread_local bool        gIsConsoleFormatting{false};
 
-        SE_LOGD("JS: %s%s\n", prefix, msg.c_str());
+void jsbConsoleFormatLog(State &state, const char *prefix, int msgIndex = 0) {
+    int argc = static_cast<int>(state.argCount());
+    if (msgIndex < 0 || argc <= msgIndex) {
+        return;
     }
 
+    // toString of an argument may log again, the nested call uses its own buffers.
+    std::string  nestedFormat;
+    std::string  nestedMsg;
+    const bool   isNested = gIsConsoleFormatting;
+    std::string &format   = isNested ? nestedFormat : gConsoleFormat;
+    std::string &msg      = isNested ? nestedMsg : gConsoleBuffer;
+    gIsConsoleFormatting  = true;
+
+    // Arguments are formatted from JavaScript values directly, se::Value isn't involved.
+    format.clear();
+    state.appendArgToLog(msgIndex, &format);
+
+    msg.assign("JS: ");
+    msg.append(prefix);
+    size_t pos = 0;
+    int    i   = msgIndex + 1;
+    // %d, %s and %f are substituted in order, the rest arguments are appended once any other '%' is met.
+    for (; i < argc; ++i) {
+        size_t found = format.find('%', pos);
+        if (found == std::string::npos || found == (format.length() - 1) || (format[found + 1] != 'd' && format[found + 1] != 's' && format[found + 1] != 'f')) {
+            break;
+        }
+        msg.append(format, pos, found - pos);
+        state.appendArgToLog(i, &msg);
+        pos = found + 2;
+    }
+    msg.append(format, pos, std::string::npos);
+    for (; i < argc; ++i) {
+        msg.append(" ");
+        state.appendArgToLog(i, &msg);
+    }
+    msg.append("\n");
+    gIsConsoleFormatting = isNested;
+    SE_LOGD("%s", msg.c_str());
+}
+
+bool jsbConsoleOutput(State &s, ScriptEngine::ConsoleLevel level, const char *prefix, const Value &oldConsoleFunc, int msgIndex = 0) {
+    ScriptEngine *engine = ScriptEngine::getInstance();
+    if (level < engine->getConsoleLevel()) {
+        return true;
+    }
+    jsbConsoleFormatLog(s, prefix, msgIndex);
+    if (engine->isConsoleForwarded() && oldConsoleFunc.isObject()) {
+        oldConsoleFunc.toObject()->call(s.args(), s.thisObject());
+    }
     return true;
 }
 
 bool jsbConsoleLog(State &s) {
-    jsbConsoleFormatLog(s, "");
-    oldConsoleLog.toObject()->call(s.args(), s.thisObject());
-    return true;
+    return jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::LOG, "", oldConsoleLog);
 }
 SE_BIND_FUNC(jsbConsoleLog)
 
 bool jsbConsoleDebug(State &s) {
-    jsbConsoleFormatLog(s, "[DEBUG]: ");
-    oldConsoleDebug.toObject()->call(s.args(), s.thisObject());
-    return true;
+    return jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::LEVEL_DEBUG, "[DEBUG]: ", oldConsoleDebug);
 }
 SE_BIND_FUNC(jsbConsoleDebug)
 
 bool jsbConsoleInfo(State &s) {
-    jsbConsoleFormatLog(s, "[INFO]: ");
-    oldConsoleInfo.toObject()->call(s.args(), s.thisObject());
-    return true;
+    return jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::INFO, "[INFO]: ", oldConsoleInfo);
 }
 SE_BIND_FUNC(jsbConsoleInfo)
 
 bool jsbConsoleWarn(State &s) {
-    jsbConsoleFormatLog(s, "[WARN]: ");
-    oldConsoleWarn.toObject()->call(s.args(), s.thisObject());
-    return true;
+    return jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::WARN, "[WARN]: ", oldConsoleWarn);
 }
 SE_BIND_FUNC(jsbConsoleWarn)
 
 bool jsbConsoleError(State &s) {
-    jsbConsoleFormatLog(s, "[ERROR]: ");
-    oldConsoleError.toObject()->call(s.args(), s.thisObject());
-    return true;
+    return jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::ERR, "[ERROR]: ", oldConsoleError);
 }
 SE_BIND_FUNC(jsbConsoleError)
 
 bool jsbConsoleAssert(State &s) {
+    if (ScriptEngine::ConsoleLevel::ERR < ScriptEngine::getInstance()->getConsoleLevel()) {
+        return true;
+    }
     const auto &args = s.args();
     if (!args.empty()) {
         if (args[0].isBoolean() && !args[0].toBoolean()) {
-            jsbConsoleFormatLog(s, "[ASSERT]: ", 1);
-            oldConsoleAssert.toObject()->call(s.args(), s.thisObject());
+            jsbConsoleOutput(s, ScriptEngine::ConsoleLevel::ERR, "[ASSERT]: ", oldConsoleAssert, 1);
         }
     }
     return true;
@@ -207,8 +298,8 @@ public:
         std::string flags;
         //NOTICE: spaces are required between flags
         flags.append(" --expose-gc-as=" EXPOSE_GC);
-        flags.append(" --no-flush-bytecode --no-lazy"); // for bytecode support
-                                                        // flags.append(" --trace-gc"); // v8 trace gc
+        // flags.append(" --trace-gc"); // v8 trace gc
+        // Compilation flags are applied in ScriptEngine::init, see ScriptEngine::setCompileOptions.
         #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS)
         flags.append(" --jitless");
         #endif
@@ -230,6 +321,75 @@ public:
 
 ScriptEngineV8Context *gSharedV8 = nullptr;
     #endif // CC_EDITOR
+
+// Native binding objects are written as: class name length, class name, payload size, payload.
+class SerializerDelegate : public v8::ValueSerializer::Delegate {
+public:
+    SerializerDelegate(v8::Isolate *isolate, const ScriptEngine::SerializeDelegate &delegate) : _isolate(isolate), _delegate(delegate) {}
+
+    void setSerializer(v8::ValueSerializer *serializer) { _serializer = serializer; }
+
+    void ThrowDataCloneError(v8::Local<v8::String> message) override {
+        _isolate->ThrowException(v8::Exception::Error(message));
+    }
+
+    v8::Maybe<bool> WriteHostObject(v8::Isolate *isolate, v8::Local<v8::Object> object) override {
+        auto *privateObject = static_cast<PrivateObjectBase *>(internal::getPrivate(isolate, object, 0));
+        auto *seObj         = static_cast<Object *>(internal::getPrivate(isolate, object, 1));
+        Class *cls          = seObj != nullptr ? seObj->_getClass() : nullptr;
+        _payload.clear();
+        if (seObj == nullptr || !_delegate.onWriteNativeObject || !_delegate.onWriteNativeObject(seObj, cls, privateObject, &_payload)) {
+            ThrowDataCloneError(v8::String::NewFromUtf8Literal(isolate, "Native binding object can't be serialized"));
+            return v8::Nothing<bool>();
+        }
+
+        const char *className = cls != nullptr ? cls->getName() : "";
+        auto        nameLen   = static_cast<uint32_t>(strlen(className));
+        _serializer->WriteUint32(nameLen);
+        _serializer->WriteRawBytes(className, nameLen);
+        _serializer->WriteUint32(static_cast<uint32_t>(_payload.size()));
+        _serializer->WriteRawBytes(_payload.data(), _payload.size());
+        return v8::Just(true);
+    }
+
+private:
+    v8::Isolate *                           _isolate;
+    const ScriptEngine::SerializeDelegate &_delegate;
+    v8::ValueSerializer *                   _serializer{nullptr};
+    std::vector<uint8_t>                    _payload;
+};
+
+class DeserializerDelegate : public v8::ValueDeserializer::Delegate {
+public:
+    explicit DeserializerDelegate(const ScriptEngine::SerializeDelegate &delegate) : _delegate(delegate) {}
+
+    void setDeserializer(v8::ValueDeserializer *deserializer) { _deserializer = deserializer; }
+
+    v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate *isolate) override {
+        uint32_t    nameLen     = 0;
+        uint32_t    payloadSize = 0;
+        const void *name        = nullptr;
+        const void *payload     = nullptr;
+        if (!_deserializer->ReadUint32(&nameLen) || !_deserializer->ReadRawBytes(nameLen, &name) ||
+            !_deserializer->ReadUint32(&payloadSize) || !_deserializer->ReadRawBytes(payloadSize, &payload)) {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "Invalid native binding object data")));
+            return {};
+        }
+
+        std::string className(static_cast<const char *>(name), nameLen);
+        Object *    seObj = _delegate.onReadNativeObject ? _delegate.onReadNativeObject(className.c_str(), static_cast<const uint8_t *>(payload), payloadSize) : nullptr;
+        if (seObj == nullptr) {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "Native binding object can't be deserialized")));
+            return {};
+        }
+
+        return seObj->_getJSObject();
+    }
+
+private:
+    const ScriptEngine::SerializeDelegate &_delegate;
+    v8::ValueDeserializer *                 _deserializer{nullptr};
+};
 } // namespace
 
 void ScriptEngine::callExceptionCallback(const char *location, const char *message, const char *stack) {
@@ -269,189 +429,271 @@ void ScriptEngine::onOOMErrorCallback(const char *location, bool isHeapOom) {
 }
 
 void ScriptEngine::onMessageCallback(v8::Local<v8::Message> message, v8::Local<v8::Value> /*data*/) {
-    ScriptEngine *        thiz = getInstance();
-    v8::Local<v8::String> msg  = message->Get();
-    Value                 msgVal;
-    internal::jsToSeValue(v8::Isolate::GetCurrent(), msg, &msgVal);
-    assert(msgVal.isString());
-    v8::ScriptOrigin origin = message->GetScriptOrigin();
-    Value            resouceNameVal;
-    internal::jsToSeValue(v8::Isolate::GetCurrent(), origin.ResourceName(), &resouceNameVal);
-    Value line(origin.LineOffset());
-    Value column(origin.ColumnOffset());
-
-    std::string location = resouceNameVal.toStringForce() + ":" + line.toStringForce() + ":" + column.toStringForce();
-
-    std::string errorStr = msgVal.toString() + ", location: " + location;
-    std::string stackStr = stackTraceToString(message->GetStackTrace());
-    if (!stackStr.empty()) {
-        if (line.toInt32() == 0) {
-            location = "(see stack)";
+    ScriptEngine *thiz = getInstance();
+    thiz->recordException(message);
+    if (std::chrono::steady_clock::now() - thiz->_lastExceptionReportTime >= thiz->_exceptionReportInterval) {
+        thiz->flushExceptions();
+    }
+}
+
+void ScriptEngine::recordException(v8::Local<v8::Message> message) {
+    v8::Local<v8::Context> context = _isolate->GetCurrentContext();
+    v8::String::Utf8Value  msg(_isolate, message->Get());
+    v8::String::Utf8Value  resourceName(_isolate, message->GetScriptResourceName());
+    int                    line   = message->GetLineNumber(context).FromMaybe(0);
+    int                    column = message->GetStartColumn(context).FromMaybe(0);
+
+    // Identical exceptions only increase the counter, the stack isn't walked again.
+    // The hash only filters candidates, a collision must not merge different exceptions.
+    const char *msgStr          = *msg != nullptr ? *msg : "";
+    const char *resourceNameStr = *resourceName != nullptr ? *resourceName : "";
+    size_t      key             = std::hash<std::string>{}(msgStr);
+    key ^= std::hash<std::string>{}(resourceNameStr) + 0x9e3779b9 + (key << 6U) + (key >> 2U);
+    key ^= (static_cast<size_t>(line) << 16U) ^ static_cast<size_t>(column);
+    for (size_t i = 0; i < _exceptionRecordKeys.size(); ++i) {
+        const ExceptionRecord &existing = _exceptionRecords[i];
+        if (_exceptionRecordKeys[i] == key && existing.line == line && existing.column == column &&
+            existing.message == msgStr && existing.resourceName == resourceNameStr) {
+            ++_exceptionRecords[i].count;
+            return;
         }
-        errorStr += "\nSTACK:\n" + stackStr;
     }
-    SE_LOGE("ERROR: %s\n", errorStr.c_str());
 
-    thiz->callExceptionCallback(location.c_str(), msgVal.toString().c_str(), stackStr.c_str());
+    ExceptionRecord record;
+    record.message      = msgStr;
+    record.resourceName = resourceNameStr;
+    record.line         = line;
+    record.column       = column;
+    record.count        = 1;
+
+    v8::Local<v8::StackTrace> stack = message->GetStackTrace();
+    if (!stack.IsEmpty()) {
+        int frameCount = stack->GetFrameCount();
+        record.frames.reserve(frameCount);
+        for (int i = 0; i < frameCount; ++i) {
+            v8::Local<v8::StackFrame> frame = stack->GetFrame(_isolate, i);
+            ExceptionFrame            info;
+            v8::Local<v8::String>     func = frame->GetFunctionName();
+            if (!func.IsEmpty()) {
+                info.functionName = *v8::String::Utf8Value(_isolate, func);
+            }
+            v8::Local<v8::String> script = frame->GetScriptName();
+            if (!script.IsEmpty()) {
+                info.scriptName = *v8::String::Utf8Value(_isolate, script);
+            }
+            info.line   = frame->GetLineNumber();
+            info.column = frame->GetColumn();
+            record.frames.push_back(std::move(info));
+        }
+    }
+
+    if (_exceptionRecords.size() < _exceptionRecordCapacity) {
+        _exceptionRecords.push_back(std::move(record));
+        _exceptionRecordKeys.push_back(key);
+    } else if (_exceptionRecordCapacity > 0) {
+        // Ring buffer is full, overwrite the oldest record.
+        _exceptionRecords[_exceptionRecordHead]    = std::move(record);
+        _exceptionRecordKeys[_exceptionRecordHead] = key;
+        _exceptionRecordHead                       = (_exceptionRecordHead + 1) % _exceptionRecordCapacity;
+        ++_droppedExceptionCount;
+    } else {
+        ++_droppedExceptionCount;
+    }
+}
+
+void ScriptEngine::flushExceptions() {
+    if (_isFlushingExceptions || (_exceptionRecords.empty() && _droppedExceptionCount == 0)) {
+        return;
+    }
+    _isFlushingExceptions    = true;
+    _lastExceptionReportTime = std::chrono::steady_clock::now();
+
+    // Records fired by the callbacks below are kept for the next report.
+    std::rotate(_exceptionRecords.begin(), _exceptionRecords.begin() + static_cast<std::ptrdiff_t>(_exceptionRecordHead), _exceptionRecords.end());
+    std::vector<ExceptionRecord> records = std::move(_exceptionRecords);
+    uint32_t                     dropped = _droppedExceptionCount;
+    _exceptionRecords.clear();
+    _exceptionRecordKeys.clear();
+    _exceptionRecordHead   = 0;
+    _droppedExceptionCount = 0;
 
-    if (!thiz->_isErrorHandleWorking) {
-        thiz->_isErrorHandleWorking = true;
+    if (dropped > 0) {
+        SE_LOGE("ERROR: %u exception records are dropped\n", dropped);
+    }
+
+    v8::HandleScope handleScope(_isolate);
+    Value           errorHandler;
+    bool            hasErrorHandler = !_isErrorHandleWorking && _globalObj != nullptr && _globalObj->getProperty("__errorHandler", &errorHandler) && errorHandler.isObject() && errorHandler.toObject()->isFunction();
+
+    for (auto &record : records) {
+        if (_isSourceMapEnabled) {
+            symbolicateException(&record);
+        }
+        std::string location = record.getLocation();
+        std::string stackStr = record.getStackString();
+        if (record.count > 1) {
+            SE_LOGE("ERROR: %s, location: %s (repeated %u times)\n", record.message.c_str(), location.c_str(), record.count);
+        } else {
+            SE_LOGE("ERROR: %s, location: %s\n", record.message.c_str(), location.c_str());
+        }
+        if (!stackStr.empty()) {
+            SE_LOGE("STACK:\n%s\n", stackStr.c_str());
+        }
+
+        callExceptionCallback(location.c_str(), record.message.c_str(), stackStr.c_str());
 
-        Value errorHandler;
-        if (thiz->_globalObj && thiz->_globalObj->getProperty("__errorHandler", &errorHandler) && errorHandler.isObject() && errorHandler.toObject()->isFunction()) {
+        if (hasErrorHandler) {
+            _isErrorHandleWorking = true;
             ValueArray args;
-            args.push_back(resouceNameVal);
-            args.push_back(line);
-            args.push_back(msgVal);
+            args.push_back(Value(record.resourceName));
+            args.push_back(Value(record.line));
+            args.push_back(Value(record.message));
             args.push_back(Value(stackStr));
-            errorHandler.toObject()->call(args, thiz->_globalObj);
+            errorHandler.toObject()->call(args, _globalObj);
+            _isErrorHandleWorking = false;
         }
+    }
 
-        thiz->_isErrorHandleWorking = false;
-    } else {
-        SE_LOGE("ERROR: __errorHandler has exception\n");
+    if (_exceptionBatchCallback) {
+        _exceptionBatchCallback(records, dropped);
+    }
+
+    _isFlushingExceptions = false;
+}
+
+void ScriptEngine::symbolicateException(ExceptionRecord *record) {
+    std::string source;
+    int         line   = 0;
+    int         column = 0;
+    // Column of the message is 0-based.
+    if (symbolicate(record->resourceName, record->line, record->column + 1, &source, &line, &column)) {
+        record->resourceName = source;
+        record->line         = line;
+        record->column       = column - 1;
+    }
+    for (auto &frame : record->frames) {
+        if (symbolicate(frame.scriptName, frame.line, frame.column, &source, &line, &column)) {
+            frame.scriptName = source;
+            frame.line       = line;
+            frame.column     = column;
+        }
+    }
+}
+
+void ScriptEngine::setExceptionBatchCallback(const ExceptionBatchCallback &cb) {
+    _exceptionBatchCallback = cb;
+}
+
+void ScriptEngine::setExceptionReportOptions(size_t capacity, float intervalInSeconds) {
+    flushExceptions();
+    _exceptionRecordCapacity = capacity;
+    _exceptionReportInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(intervalInSeconds));
+    _exceptionRecords.reserve(capacity);
+    _exceptionRecordKeys.reserve(capacity);
+}
+
+std::string ScriptEngine::ExceptionRecord::getLocation() const {
+    if (line == 0 && !frames.empty()) {
+        return "(see stack)";
+    }
+    return resourceName + ":" + std::to_string(line) + ":" + std::to_string(column);
+}
+
+std::string ScriptEngine::ExceptionRecord::getStackString() const {
+    std::string stackStr;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const auto &frame = frames[i];
+        stackStr += " - [" + std::to_string(i) + "]";
+        stackStr += frame.functionName.empty() ? "anonymous" : frame.functionName;
+        stackStr += "@";
+        stackStr += frame.scriptName.empty() ? "(no filename)" : frame.scriptName;
+        stackStr += ":" + std::to_string(frame.line);
+        if (i < frames.size() - 1) {
+            stackStr += "\n";
+        }
     }
+    return stackStr;
 }
+
 /**
 * Bug in v8 stacktrace:
 * "handlerAddedAfterPromiseRejected" event is triggered if a resolve handler is added.
 * But if no reject handler is added, then "unhandledRejectedPromise" exception will be called again, but the stacktrace this time become empty
-* LastStackTrace is used to store it.
+* _lastPromiseStackTrace is used to store it.
 */
-void ScriptEngine::pushPromiseExeception(const v8::Local<v8::Promise> &promise, const char *event, const char *stackTrace) {
-    using element_type = decltype(_promiseArray)::value_type;
-    element_type *current;
-
-    auto itr = std::find_if(_promiseArray.begin(), _promiseArray.end(), [&](const auto &e) -> bool {
-        return std::get<0>(e)->Get(_isolate) == promise;
-    });
-
-    if (itr == _promiseArray.end()) { //Not found, create one
-        _promiseArray.emplace_back(std::make_unique<v8::Persistent<v8::Promise>>(), std::vector<PromiseExceptionMsg>{});
-        std::get<0>(_promiseArray.back())->Reset(_isolate, promise);
-        current = &_promiseArray.back();
-    } else {
-        current = &(*itr);
-    }
-
-    auto &exceptions = std::get<1>(*current);
+void ScriptEngine::trackPromiseRejection(v8::Local<v8::Promise> promise, const char *event, v8::Local<v8::Value> value, StackTrace &&stack) {
+    int  hash  = promise->GetIdentityHash();
+    auto range = _promiseRejections.equal_range(hash);
     if (std::strcmp(event, "handlerAddedAfterPromiseRejected") == 0) {
-        for (int i = 0; i < exceptions.size(); i++) {
-            if (exceptions[i].event == "unhandledRejectedPromise") {
-                _lastStackTrace = exceptions[i].stackTrace;
-                exceptions.erase(exceptions.begin() + i);
+        for (auto it = range.first; it != range.second; ++it) {
+            PromiseRejection &rejection = it->second;
+            if (std::strcmp(rejection.event, "unhandledRejectedPromise") == 0 && rejection.promise == promise) {
+                _lastPromiseStackTrace = std::move(rejection.stack);
+                _promiseRejections.erase(it);
                 return;
             }
         }
     }
-    exceptions.push_back(PromiseExceptionMsg{event, stackTrace});
+
+    if (_promiseRejections.size() >= _maxTrackedPromiseRejections) {
+        ++_droppedPromiseRejectionCount;
+        return;
+    }
+
+    PromiseRejection rejection;
+    rejection.event = event;
+    rejection.promise.Reset(_isolate, promise);
+    if (!value.IsEmpty()) {
+        rejection.value.Reset(_isolate, value);
+    }
+    if (stack.getFrameCount() == 0 && !_lastPromiseStackTrace.isEmpty()) {
+        rejection.stack = StackTrace(_lastPromiseStackTrace._getStackTrace());
+    } else {
+        rejection.stack = std::move(stack);
+    }
+    _promiseRejections.emplace(hash, std::move(rejection));
 }
 
 void ScriptEngine::handlePromiseExceptions() {
-    if (_promiseArray.empty()) {
+    if (_promiseRejections.empty() && _droppedPromiseRejectionCount == 0) {
         return;
     }
-    for (auto &exceptionsPair : _promiseArray) {
-        auto &exceptionVector = std::get<1>(exceptionsPair);
-        for (const auto &exceptions : exceptionVector) {
-            getInstance()->callExceptionCallback("", exceptions.event.c_str(), exceptions.stackTrace.c_str());
-        }
-        std::get<0>(exceptionsPair).get()->Reset();
+
+    v8::HandleScope scope(_isolate);
+    for (auto &item : _promiseRejections) {
+        PromiseRejection &rejection = item.second;
+        std::string       report    = formatPromiseRejection(_isolate, rejection.promise.Get(_isolate), rejection.value.Get(_isolate), rejection.stack);
+        callExceptionCallback("", rejection.event, report.c_str());
     }
-    _promiseArray.clear();
-    _lastStackTrace.clear();
+    if (_droppedPromiseRejectionCount > 0) {
+        SE_LOGE("ERROR: %u promise rejections aren't tracked\n", _droppedPromiseRejectionCount);
+    }
+
+    _promiseRejections.clear();
+    _droppedPromiseRejectionCount = 0;
+    _lastPromiseStackTrace.reset();
 }
 
 void ScriptEngine::onPromiseRejectCallback(v8::PromiseRejectMessage msg) {
     /* Reject message contains different types, yet not every type will lead to the exception in the end.
      * A detection is needed: if the reject handler is added after the promise is triggered, it's actually valid.*/
-    v8::Isolate *     isolate = getInstance()->_isolate;
-    v8::HandleScope   scope(isolate);
-    std::stringstream ss;
-    auto              event       = msg.GetEvent();
-    auto              value       = msg.GetValue();
-    auto              promiseName = msg.GetPromise()->GetConstructorName();
-
-    if (!value.IsEmpty()) {
-        // prepend error object to stack message
-        v8::MaybeLocal<v8::String> maybeStr = value->ToString(isolate->GetCurrentContext());
-        v8::Local<v8::String>      str      = maybeStr.IsEmpty() ? v8::String::NewFromUtf8(isolate, "[empty string]").ToLocalChecked() : maybeStr.ToLocalChecked();
-        v8::String::Utf8Value      valueUtf8(isolate, str);
-        auto *                     strp = *valueUtf8;
-        if (strp == nullptr) {
-            ss << "value: null" << std::endl;
-            auto                  tn = value->TypeOf(isolate);
-            v8::String::Utf8Value tnUtf8(isolate, tn);
-            strp = *tnUtf8;
-            if (strp) {
-                ss << " type: " << strp << std::endl;
-            }
-            if (value->IsObject()) {
-                v8::MaybeLocal<v8::String> json = v8::JSON::Stringify(isolate->GetCurrentContext(), value);
-                if (!json.IsEmpty()) {
-                    v8::String::Utf8Value jsonStr(isolate, json.ToLocalChecked());
-                    strp = *jsonStr;
-                    if (strp) {
-                        ss << " obj: " << strp << std::endl;
-                    } else {
-                        ss << " obj: null" << std::endl;
-                    }
-                } else {
-                    v8::Local<v8::Object> obj       = value->ToObject(isolate->GetCurrentContext()).ToLocalChecked();
-                    v8::Local<v8::Array>  attrNames = obj->GetOwnPropertyNames(isolate->GetCurrentContext()).ToLocalChecked();
+    ScriptEngine *  thiz    = getInstance();
+    v8::Isolate *   isolate = thiz->_isolate;
+    v8::HandleScope scope(isolate);
 
-                    if (!attrNames.IsEmpty()) {
-                        uint32_t size = attrNames->Length();
-
-                        for (uint32_t i = 0; i < size; i++) {
-                            se::Value             e;
-                            v8::Local<v8::String> attrName = attrNames->Get(isolate->GetCurrentContext(), i)
-                                                                 .ToLocalChecked()
-                                                                 ->ToString(isolate->GetCurrentContext())
-                                                                 .ToLocalChecked();
-                            v8::String::Utf8Value attrUtf8(isolate, attrName);
-                            strp = *attrUtf8;
-                            ss << " obj.property " << strp << std::endl;
-                        }
-                        ss << " obj: JSON.parse failed!" << std::endl;
-                    }
-                }
-            }
-
-        } else {
-            ss << *valueUtf8 << std::endl;
-        }
-
-        v8::String::Utf8Value valuePromiseConstructor(isolate, promiseName);
-        strp = *valuePromiseConstructor;
-        if (strp) {
-            ss << "PromiseConstructor " << strp;
-        }
-    }
-
-    auto stackStr = getInstance()->getCurrentStackTrace();
-    ss << "stacktrace: " << std::endl;
-    if (stackStr.empty()) {
-        ss << getInstance()->_lastStackTrace << std::endl;
-    } else {
-        ss << stackStr << std::endl;
-    }
     //Check event immediately, for certain case throw exception.
-    const char *eventName;
-    switch (event) {
+    switch (msg.GetEvent()) {
         case v8::kPromiseRejectWithNoHandler:
-            eventName = "unhandledRejectedPromise";
-            getInstance()->pushPromiseExeception(msg.GetPromise(), "unhandledRejectedPromise", ss.str().c_str());
+            thiz->trackPromiseRejection(msg.GetPromise(), "unhandledRejectedPromise", msg.GetValue(), StackTrace::capture());
             break;
         case v8::kPromiseHandlerAddedAfterReject:
-            eventName = "handlerAddedAfterPromiseRejected";
-            getInstance()->pushPromiseExeception(msg.GetPromise(), "handlerAddedAfterPromiseRejected", ss.str().c_str());
+            thiz->trackPromiseRejection(msg.GetPromise(), "handlerAddedAfterPromiseRejected", msg.GetValue(), StackTrace::capture());
             break;
         case v8::kPromiseRejectAfterResolved:
-            getInstance()->callExceptionCallback("", "rejectAfterPromiseResolved", stackStr.c_str());
+            thiz->callExceptionCallback("", "rejectAfterPromiseResolved", thiz->getCurrentStackTrace().c_str());
             break;
         case v8::kPromiseResolveAfterResolved:
-            getInstance()->callExceptionCallback("", "resolveAfterPromiseResolved", stackStr.c_str());
+            thiz->callExceptionCallback("", "resolveAfterPromiseResolved", thiz->getCurrentStackTrace().c_str());
             break;
     }
 }
@@ -484,6 +726,68 @@ void ScriptEngine::destroyInstance() {
     }
 }
 
+// Lock-free multiple producers single consumer queue, producers only exchange the head and link the previous node.
+class ScriptEngine::TaskQueue {
+public:
+    TaskQueue() : _head(&_stub), _tail(&_stub) {}
+
+    ~TaskQueue() {
+        std::function<void()> task;
+        while (pop(&task)) {
+        }
+    }
+
+    void push(std::function<void()> &&task) {
+        auto *node = new Node();
+        node->task = std::move(task);
+        pushNode(node);
+    }
+
+    // Only invoked by the thread of script engine.
+    bool pop(std::function<void()> *task) {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &_stub) {
+            if (next == nullptr) {
+                return false;
+            }
+            _tail = next;
+            tail  = next;
+            next  = next->next.load(std::memory_order_acquire);
+        }
+        if (next == nullptr) {
+            if (tail != _head.load(std::memory_order_acquire)) {
+                return false; // A producer is linking its node, the task will be run next time.
+            }
+            pushNode(&_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+        }
+        _tail = next;
+        *task = std::move(tail->task);
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node *>   next{nullptr};
+        std::function<void()> task;
+    };
+
+    void pushNode(Node *node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node *prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    std::atomic<Node *> _head;
+    Node *              _tail;
+    Node                _stub;
+};
+
 ScriptEngine::ScriptEngine()
 : _isolate(nullptr),
   _handleScope(nullptr),
@@ -500,6 +804,8 @@ ScriptEngine::ScriptEngine()
   _isGarbageCollecting(false),
   _isInCleanup(false),
   _isErrorHandleWorking(false) {
+    // The queue lives as long as the engine, postTask may be invoked from any thread at any time.
+    _taskQueue = std::make_unique<TaskQueue>();
     #if !CC_EDITOR
     if (!gSharedV8) {
         gSharedV8 = new ScriptEngineV8Context();
@@ -512,11 +818,13 @@ ScriptEngine::~ScriptEngine() = default;
 bool ScriptEngine::postInit() {
     v8::HandleScope hs(_isolate);
     _isolate->Enter();
-    _isolate->SetCaptureStackTraceForUncaughtExceptions(true, JSB_STACK_FRAME_LIMIT, v8::StackTrace::kOverview);
+    _isolate->SetCaptureStackTraceForUncaughtExceptions(_uncaughtStackFrameLimit > 0, static_cast<int>(_uncaughtStackFrameLimit), _uncaughtStackDetail == StackTrace::Detail::DETAILED ? v8::StackTrace::kDetailed : v8::StackTrace::kOverview);
     _isolate->SetFatalErrorHandler(onFatalErrorCallback);
     _isolate->SetOOMErrorHandler(onOOMErrorCallback);
     _isolate->AddMessageListener(onMessageCallback);
     _isolate->SetPromiseRejectCallback(onPromiseRejectCallback);
+    _isolate->AddNearHeapLimitCallback(onNearHeapLimitCallback, this);
+    _isolate->AutomaticallyRestoreInitialHeapLimit();
 
     NativePtrToObjectMap::init();
     Object::setup();
@@ -570,6 +878,20 @@ bool ScriptEngine::postInit() {
     return _isValid;
 }
 
+void ScriptEngine::setCompileOptions(const CompileOptions &options) {
+    assert(!_isValid); // Flags can't be changed safely after isolate is created.
+    _compileOptions = options;
+}
+
+void ScriptEngine::applyCompileOptions() {
+    std::string flags;
+    //NOTICE: spaces are required between flags
+    flags.append(_compileOptions.eagerCompile ? " --no-lazy" : " --lazy");
+    bool flushBytecode = _compileOptions.flushBytecode && _compileOptions.codeCache == CodeCacheMode::NONE;
+    flags.append(flushBytecode ? " --flush-bytecode" : " --no-flush-bytecode");
+    v8::V8::SetFlagsFromString(flags.c_str(), static_cast<int>(flags.length()));
+}
+
 bool ScriptEngine::init() {
     return init(nullptr);
 }
@@ -587,11 +909,13 @@ bool ScriptEngine::init(v8::Isolate *isolate) {
     _beforeInitHookArray.clear();
 
     if (isolate != nullptr) {
+        // The isolate given by the embedder, e.g. the editor, is running already, V8 flags can't be changed safely.
         _isolate                       = isolate;
         v8::Local<v8::Context> context = _isolate->GetCurrentContext();
         _context.Reset(_isolate, context);
         _context.Get(isolate)->Enter();
     } else {
+        applyCompileOptions();
         v8::Isolate::CreateParams createParams;
         createParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
         _isolate                            = v8::Isolate::New(createParams);
@@ -613,6 +937,11 @@ void ScriptEngine::cleanup() {
 
     {
         AutoHandleScope hs;
+        flushExceptions();
+        // Pending tasks are dropped, the queue itself is kept since other threads may be posting to it.
+        std::function<void()> task;
+        while (_taskQueue->pop(&task)) {
+        }
         for (const auto &hook : _beforeCleanupHookArray) {
             hook();
         }
@@ -632,6 +961,10 @@ void ScriptEngine::cleanup() {
         oldConsoleError.setUndefined();
         oldConsoleAssert.setUndefined();
 
+        _promiseRejections.clear();
+        _sourceMaps.clear();
+        _lastPromiseStackTrace.reset();
+
     #if SE_ENABLE_INSPECTOR
 
         if (_env != nullptr) {
@@ -667,6 +1000,7 @@ void ScriptEngine::cleanup() {
         hook();
     }
     _afterCleanupHookArray.clear();
+    _memoryPressureHookArray.clear();
 
     _isInCleanup = false;
     NativePtrToObjectMap::destroy();
@@ -800,13 +1134,7 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
         fileName = "(no filename)";
     }
 
-    // Fix the source url is too long displayed in Chrome debugger.
-    std::string              sourceUrl  = fileName;
-    static const std::string PREFIX_KEY = "/temp/quick-scripts/";
-    size_t                   prefixPos  = sourceUrl.find(PREFIX_KEY);
-    if (prefixPos != std::string::npos) {
-        sourceUrl = sourceUrl.substr(prefixPos + PREFIX_KEY.length());
-    }
+    std::string sourceUrl = getSourceUrl(fileName);
 
     // It is needed, or will crash if invoked from non C++ context, such as invoked from objective-c context(for example, handler of UIKit).
     v8::HandleScope handleScope(_isolate);
@@ -824,13 +1152,38 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
 
     v8::ScriptOrigin           origin(_isolate, originStr.ToLocalChecked());
     v8::MaybeLocal<v8::Script> maybeScript = v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+    return runCompiledScript(maybeScript, sourceUrl, fileName, script, length, ret);
+}
 
+bool ScriptEngine::runCompiledScript(v8::MaybeLocal<v8::Script> maybeScript, const std::string &sourceUrl, const char *fileName, const char *source, size_t length, Value *ret) {
     bool success = false;
 
     if (!maybeScript.IsEmpty()) {
         v8::TryCatch block(_isolate);
 
-        v8::Local<v8::Script>     v8Script    = maybeScript.ToLocalChecked();
+        v8::Local<v8::Script> v8Script = maybeScript.ToLocalChecked();
+        if (_isSourceMapEnabled) {
+            // Only the url is recorded here, the source map is loaded while it's used for the first time.
+            v8::Local<v8::Value> sourceMapUrl = v8Script->GetUnboundScript()->GetSourceMappingURL();
+            if (sourceMapUrl->IsString()) {
+                std::string url = *v8::String::Utf8Value(_isolate, sourceMapUrl);
+                if (url.compare(0, 5, "data:") != 0) {
+                    std::string fileDir = _fileOperationDelegate.isValid() ? _fileOperationDelegate.onGetFileDir(fileName) : "";
+                    if (!fileDir.empty() && fileDir.back() != '/') {
+                        fileDir += '/';
+                    }
+                    SourceMapEntry &entry = _sourceMaps[sourceUrl];
+                    entry.mapPath         = url[0] == '/' ? url : fileDir + url;
+                    // The content is hashed since a rebuilt script may keep its url and length while its mappings change.
+                    char hash[32] = {0};
+                    snprintf(hash, sizeof(hash), ":%zx", std::hash<std::string_view>{}(std::string_view(source, length)));
+                    entry.fingerprint = url + ":" + std::to_string(length) + hash;
+                    entry.sourceMap.reset();
+                    entry.isLoaded = false;
+                }
+            }
+        }
+
         v8::MaybeLocal<v8::Value> maybeResult = v8Script->Run(_context.Get(_isolate));
 
         if (!maybeResult.IsEmpty()) {
@@ -861,9 +1214,15 @@ std::string ScriptEngine::getCurrentStackTrace() {
         return std::string();
     }
 
-    v8::HandleScope           hs(_isolate);
-    v8::Local<v8::StackTrace> stack = v8::StackTrace::CurrentStackTrace(_isolate, JSB_STACK_FRAME_LIMIT, v8::StackTrace::kOverview);
-    return stackTraceToString(stack);
+    return StackTrace::capture().toString();
+}
+
+void ScriptEngine::setUncaughtExceptionStackTrace(uint32_t frameLimit, StackTrace::Detail detail) {
+    _uncaughtStackFrameLimit = frameLimit;
+    _uncaughtStackDetail     = detail;
+    if (_isolate != nullptr && _isValid) {
+        _isolate->SetCaptureStackTraceForUncaughtExceptions(frameLimit > 0, static_cast<int>(frameLimit), detail == StackTrace::Detail::DETAILED ? v8::StackTrace::kDetailed : v8::StackTrace::kOverview);
+    }
 }
 
 void ScriptEngine::setFileOperationDelegate(const FileOperationDelegate &delegate) {
@@ -874,6 +1233,139 @@ const ScriptEngine::FileOperationDelegate &ScriptEngine::getFileOperationDelegat
     return _fileOperationDelegate;
 }
 
+void ScriptEngine::setSourceMapEnabled(bool enabled, const std::string &cacheDir) {
+    _isSourceMapEnabled = enabled;
+    _sourceMapCacheDir  = cacheDir;
+    if (!enabled) {
+        _sourceMaps.clear();
+    }
+}
+
+SourceMap *ScriptEngine::getSourceMap(const std::string &scriptName) {
+    auto iter = _sourceMaps.find(scriptName);
+    if (iter == _sourceMaps.end()) {
+        return nullptr;
+    }
+
+    SourceMapEntry &entry = iter->second;
+    if (entry.isLoaded) {
+        return entry.sourceMap.get();
+    }
+    entry.isLoaded = true;
+    if (!_fileOperationDelegate.isValid()) {
+        return nullptr;
+    }
+
+    auto        sourceMap = std::make_unique<SourceMap>();
+    std::string fullPath  = _fileOperationDelegate.onGetFullPath(entry.mapPath);
+    std::string cachePath;
+    if (!_sourceMapCacheDir.empty()) {
+        char name[32] = {0};
+        snprintf(name, sizeof(name), "/%zx.smi", std::hash<std::string>{}(fullPath));
+        cachePath = _sourceMapCacheDir + name;
+
+        bool isCacheLoaded = false;
+        if (_fileOperationDelegate.onCheckFileExist(cachePath)) {
+            _fileOperationDelegate.onGetDataFromFile(cachePath, [&](const uint8_t *data, size_t size) {
+                isCacheLoaded = sourceMap->loadIndex(data, size, entry.fingerprint);
+            });
+        }
+        if (isCacheLoaded) {
+            entry.sourceMap = std::move(sourceMap);
+            return entry.sourceMap.get();
+        }
+    }
+
+    if (!_fileOperationDelegate.onCheckFileExist(fullPath)) {
+        SE_LOGD("ScriptEngine::getSourceMap, %s doesn't exist\n", entry.mapPath.c_str());
+        return nullptr;
+    }
+    std::string json = _fileOperationDelegate.onGetStringFromFile(fullPath);
+    if (!sourceMap->parse(json.data(), json.length())) {
+        SE_LOGE("ScriptEngine::getSourceMap, failed to parse %s\n", entry.mapPath.c_str());
+        return nullptr;
+    }
+
+    if (!cachePath.empty()) {
+        if (!_fileOperationDelegate.onCheckDirectoryExist(_sourceMapCacheDir)) {
+            _fileOperationDelegate.onCreateDirectory(_sourceMapCacheDir);
+        }
+        _fileOperationDelegate.onWriteFile(sourceMap->saveIndex(entry.fingerprint), cachePath);
+    }
+    entry.sourceMap = std::move(sourceMap);
+    return entry.sourceMap.get();
+}
+
+bool ScriptEngine::symbolicate(const std::string &scriptName, int line, int column, std::string *source, int *originalLine, int *originalColumn) {
+    assert(source != nullptr && originalLine != nullptr && originalColumn != nullptr);
+    if (line <= 0 || column <= 0) {
+        return false;
+    }
+    SourceMap *sourceMap    = getSourceMap(scriptName);
+    uint32_t   mappedLine   = 0;
+    uint32_t   mappedColumn = 0;
+    if (sourceMap == nullptr || !sourceMap->lookup(static_cast<uint32_t>(line - 1), static_cast<uint32_t>(column - 1), source, &mappedLine, &mappedColumn)) {
+        return false;
+    }
+    *originalLine   = static_cast<int>(mappedLine) + 1;
+    *originalColumn = static_cast<int>(mappedColumn) + 1;
+    return true;
+}
+
+void ScriptEngine::setSerializeDelegate(const SerializeDelegate &delegate) {
+    _serializeDelegate = delegate;
+}
+
+bool ScriptEngine::serialize(const Value &value, std::vector<uint8_t> *out) {
+    assert(out != nullptr);
+    v8::HandleScope        handleScope(_isolate);
+    v8::TryCatch           tryCatch(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+    v8::Local<v8::Value>   jsval;
+    internal::seToJsValue(_isolate, value, &jsval);
+
+    SerializerDelegate  delegate(_isolate, _serializeDelegate);
+    v8::ValueSerializer serializer(_isolate, &delegate);
+    delegate.setSerializer(&serializer);
+    serializer.WriteHeader();
+    v8::Maybe<bool> ok = serializer.WriteValue(context, jsval);
+    if (ok.IsNothing() || !ok.FromJust()) {
+        if (tryCatch.HasCaught()) {
+            v8::String::Utf8Value msg(_isolate, tryCatch.Exception());
+            SE_LOGE("ScriptEngine::serialize failed: %s\n", *msg);
+        }
+        return false;
+    }
+
+    std::pair<uint8_t *, size_t> buffer = serializer.Release();
+    out->assign(buffer.first, buffer.first + buffer.second);
+    free(buffer.first); // NOLINT(cppcoreguidelines-no-malloc)
+    return true;
+}
+
+bool ScriptEngine::deserialize(const uint8_t *data, size_t size, Value *value) {
+    assert(value != nullptr);
+    v8::HandleScope        handleScope(_isolate);
+    v8::TryCatch           tryCatch(_isolate);
+    v8::Local<v8::Context> context = _context.Get(_isolate);
+
+    DeserializerDelegate  delegate(_serializeDelegate);
+    v8::ValueDeserializer deserializer(_isolate, data, size, &delegate);
+    delegate.setDeserializer(&deserializer);
+    v8::Local<v8::Value> jsval;
+    if (deserializer.ReadHeader(context).IsNothing() || !deserializer.ReadValue(context).ToLocal(&jsval)) {
+        if (tryCatch.HasCaught()) {
+            v8::String::Utf8Value msg(_isolate, tryCatch.Exception());
+            SE_LOGE("ScriptEngine::deserialize failed: %s\n", *msg);
+        }
+        value->setUndefined();
+        return false;
+    }
+
+    internal::jsToSeValue(_isolate, jsval, value);
+    return true;
+}
+
 bool ScriptEngine::saveByteCodeToFile(const std::string &path, const std::string &pathBc) {
     bool  success = false;
 
@@ -930,7 +1422,13 @@ bool ScriptEngine::saveByteCodeToFile(const std::string &path, const std::string
 }
 
 bool ScriptEngine::runByteCodeFile(const std::string &pathBc, Value *ret /* = nullptr */) {
-    
+    if (_compileOptions.codeCache != CodeCacheMode::BYTECODE) {
+        // Functions restored from .bc files can't be compiled again from their dummy source once their bytecode is flushed,
+        // and V8 flags can't be changed safely on a running isolate.
+        SE_LOGE("ScriptEngine::runByteCodeFile %s, CodeCacheMode::BYTECODE should be set before init\n", pathBc.c_str());
+        return false;
+    }
+
     std::string cacheData = _fileOperationDelegate.onGetStringFromFile(pathBc);
     uint8_t *   cacheDataPtr = reinterpret_cast<uint8_t *>(const_cast<char *>(cacheData.data()));
     // read origin source file length from .bc file
@@ -1033,6 +1531,74 @@ bool ScriptEngine::runScript(const std::string &path, Value *ret /* = nullptr */
     return false;
 }
 
+bool ScriptEngine::runScripts(const std::vector<std::string> &paths) {
+    assert(_fileOperationDelegate.isValid());
+
+    // Start streaming all scripts first. Files are read in this thread since FileOperationDelegate and FileUtils aren't thread safe,
+    // only the parsing is done by worker threads.
+    std::vector<std::shared_ptr<StreamingScript>> scripts;
+    scripts.reserve(paths.size());
+    for (const auto &path : paths) {
+        auto script  = std::make_shared<StreamingScript>();
+        script->path = path;
+        scripts.push_back(script);
+        if ((path.length() > 3 && path.substr(path.length() - 3) == ".bc") || !_fileOperationDelegate.onCheckFileExist(path)) {
+            continue; // Handled by runScript in order.
+        }
+
+        script->source = _fileOperationDelegate.onGetStringFromFile(path);
+        if (script->source.empty()) {
+            continue; // Reported by runScript in order.
+        }
+
+        script->streamedSource = std::make_unique<v8::ScriptCompiler::StreamedSource>(std::make_unique<ScriptSourceStream>(&script->source), v8::ScriptCompiler::StreamedSource::UTF8);
+        script->task.reset(v8::ScriptCompiler::StartStreaming(_isolate, script->streamedSource.get()));
+        postBackgroundTask([script]() {
+            if (script->task) {
+                script->task->Run();
+            }
+            std::lock_guard<std::mutex> lock(script->mutex);
+            script->isDone = true;
+            script->cond.notify_one();
+        });
+    }
+
+    // Scripts are compiled and run in order, the rest keep streaming meanwhile.
+    bool success = true;
+    for (auto &script : scripts) {
+        if (!script->streamedSource) {
+            success = success && runScript(script->path);
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(script->mutex);
+            script->cond.wait(lock, [&]() { return script->isDone; });
+        }
+        if (!success) {
+            continue; // Wait for all streaming tasks even if a script fails.
+        }
+        if (!script->task) {
+            success = evalString(script->source.c_str(), static_cast<ssize_t>(script->source.length()), nullptr, script->path.c_str());
+            continue;
+        }
+
+        v8::HandleScope       handleScope(_isolate);
+        std::string           sourceUrl = getSourceUrl(script->path.c_str());
+        v8::Local<v8::String> fullSource;
+        v8::Local<v8::String> originStr;
+        if (!v8::String::NewFromUtf8(_isolate, script->source.c_str(), v8::NewStringType::kNormal, static_cast<int>(script->source.length())).ToLocal(&fullSource) ||
+            !v8::String::NewFromUtf8(_isolate, sourceUrl.c_str(), v8::NewStringType::kNormal).ToLocal(&originStr)) {
+            success = false;
+            continue;
+        }
+        v8::ScriptOrigin           origin(_isolate, originStr);
+        v8::MaybeLocal<v8::Script> maybeScript = v8::ScriptCompiler::Compile(_context.Get(_isolate), script->streamedSource.get(), fullSource, origin);
+        success                                = runCompiledScript(maybeScript, sourceUrl, script->path.c_str(), script->source.c_str(), script->source.length(), nullptr);
+    }
+    return success;
+}
+
 void ScriptEngine::clearException() {
     //IDEA:
 }
@@ -1067,12 +1633,136 @@ bool ScriptEngine::isDebuggerEnabled() const {
 }
 
 void ScriptEngine::mainLoopUpdate() {
-    // empty implementation
+    runPostedTasks();
+    if (!_exceptionRecords.empty() && std::chrono::steady_clock::now() - _lastExceptionReportTime >= _exceptionReportInterval) {
+        flushExceptions();
+    }
+}
+
+void ScriptEngine::onMemoryPressure(MemoryPressureLevel level) {
+    if (!_isValid) {
+        return;
+    }
+
+    SE_LOGD("ScriptEngine::onMemoryPressure, level: %d\n", static_cast<int>(level));
+    _stringPool.clear();
+    FrameArena::getInstance().trim();
+    // Source maps are loaded again on demand, from the index cache if it exists.
+    for (auto &e : _sourceMaps) {
+        e.second.sourceMap.reset();
+        e.second.isLoaded = false;
+    }
+
+    for (const auto &hook : _memoryPressureHookArray) {
+        hook(level);
+    }
+
+    if (level == MemoryPressureLevel::CRITICAL) {
+        _isolate->LowMemoryNotification();
+    } else {
+        _isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+    }
+}
+
+void ScriptEngine::addMemoryPressureHook(const std::function<void(MemoryPressureLevel)> &hook) {
+    _memoryPressureHookArray.push_back(hook);
+}
+
+size_t ScriptEngine::onNearHeapLimitCallback(void *data, size_t currentHeapLimit, size_t initialHeapLimit) {
+    auto *thiz = static_cast<ScriptEngine *>(data);
+    if (currentHeapLimit > initialHeapLimit) {
+        // Raised already and the heap hasn't shrunk back, let V8 report OOM.
+        SE_LOGE("V8 heap is near its raised limit: %zu bytes\n", currentHeapLimit);
+        return currentHeapLimit;
+    }
+
+    size_t heapLimit = currentHeapLimit + currentHeapLimit / 4;
+    SE_LOGE("V8 heap is near its limit: %zu bytes, raise it to %zu bytes temporarily\n", currentHeapLimit, heapLimit);
+    // Neither scripts nor GC could be run in this callback, caches are trimmed in next mainLoopUpdate.
+    // The initial limit is restored by V8 once the heap shrinks.
+    thiz->postTask([thiz]() {
+        thiz->onMemoryPressure(MemoryPressureLevel::CRITICAL);
+    });
+    return heapLimit;
+}
+
+void ScriptEngine::postTask(std::function<void()> task) {
+    _taskQueue->push(std::move(task));
+}
+
+void ScriptEngine::postBackgroundTask(std::function<void()> task) {
+    #if !CC_EDITOR
+    class FunctionTask final : public v8::Task {
+    public:
+        explicit FunctionTask(std::function<void()> &&func) : _func(std::move(func)) {}
+        void Run() override { _func(); }
+
+    private:
+        std::function<void()> _func;
+    };
+    gSharedV8->platform->CallOnWorkerThread(std::make_unique<FunctionTask>(std::move(task)));
+    #else
+    // The platform is owned by the editor.
+    std::thread(std::move(task)).detach();
+    #endif
+}
+
+void ScriptEngine::setTaskBudget(uint32_t maxTasks, float maxMilliseconds) {
+    _maxTasksPerTick    = maxTasks;
+    _maxTaskTimePerTick = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(maxMilliseconds));
+}
+
+uint32_t ScriptEngine::runPostedTasks() {
+    if (!_isValid) {
+        return 0;
+    }
+
+    std::function<void()> task;
+    if (!_taskQueue->pop(&task)) {
+        return 0;
+    }
+
+    v8::HandleScope handleScope(_isolate);
+    // Microtasks are performed once for the whole batch instead of after every call into JavaScript.
+    v8::MicrotasksPolicy policy = _isolate->GetMicrotasksPolicy();
+    _isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+
+    auto     deadline = std::chrono::steady_clock::now() + _maxTaskTimePerTick;
+    uint32_t count    = 0;
+    do {
+        task();
+        ++count;
+        // Reading the clock for every task is too expensive for thousands of small tasks.
+        if (_maxTaskTimePerTick.count() > 0 && (count % 16) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    } while ((_maxTasksPerTick == 0 || count < _maxTasksPerTick) && _taskQueue->pop(&task));
+
+    _isolate->SetMicrotasksPolicy(policy);
+    _isolate->PerformMicrotaskCheckpoint();
+    return count;
 }
 
 bool ScriptEngine::callFunction(Object *targetObj, const char *funcName, uint32_t argc, Value *args, Value *rval /* = nullptr*/) {
     v8::HandleScope handleScope(_isolate);
 
+    std::array<v8::Local<v8::Value>, 10>               argv;
+    std::unique_ptr<std::vector<v8::Local<v8::Value>>> vecArgs;
+    v8::Local<v8::Value> *                             pArgv = argv.data();
+
+    if (argc > argv.size()) {
+        vecArgs = std::make_unique<std::vector<v8::Local<v8::Value>>>(argc);
+        pArgv   = vecArgs->data();
+    }
+
+    for (size_t i = 0; i < argc; ++i) {
+        internal::seToJsValue(_isolate, args[i], &pArgv[i]);
+    }
+
+    return _callFunctionWithArgv(targetObj, funcName, argc, pArgv, rval);
+}
+
+bool ScriptEngine::_callFunctionWithArgv(Object *targetObj, const char *funcName, size_t argc, v8::Local<v8::Value> *argv, Value *rval) {
     v8::MaybeLocal<v8::String> nameValue = _getStringPool().get(_isolate, funcName);
 
     if (nameValue.IsEmpty()) {
@@ -1094,13 +1784,6 @@ bool ScriptEngine::callFunction(Object *targetObj, const char *funcName, uint32_
         return false;
     }
 
-    SE_ASSERT(argc < 11, "Only support argument count that less than 11"); //NOLINT
-    std::array<v8::Local<v8::Value>, 10> argv;
-
-    for (size_t i = 0; i < argc; ++i) {
-        internal::seToJsValue(_isolate, args[i], &argv[i]);
-    }
-
     #if CC_DEBUG
     v8::TryCatch tryCatch(_isolate);
     #endif
@@ -1113,7 +1796,7 @@ bool ScriptEngine::callFunction(Object *targetObj, const char *funcName, uint32_
     }
 
     v8::MaybeLocal<v8::Object> funcObj = funcVal.ToLocalChecked()->ToObject(context);
-    v8::MaybeLocal<v8::Value>  result  = funcObj.ToLocalChecked()->CallAsFunction(_getContext(), localObj, argc, argv.data());
+    v8::MaybeLocal<v8::Value>  result  = funcObj.ToLocalChecked()->CallAsFunction(_getContext(), localObj, static_cast<int>(argc), argv);
 
     #if CC_DEBUG
     if (tryCatch.HasCaught()) {
@@ -0,0 +1,336 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "SourceMap.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+    #include <algorithm>
+    #include <cstring>
+
+namespace se {
+
+namespace {
+constexpr uint32_t INDEX_MAGIC   = 0x31494D53; // "SMI1"
+constexpr uint32_t INDEX_VERSION = 1;
+
+// Returns -1 if the character isn't a base64 digit.
+int8_t base64Digit(char c) {
+    if (c >= 'A' && c <= 'Z') return static_cast<int8_t>(c - 'A');
+    if (c >= 'a' && c <= 'z') return static_cast<int8_t>(c - 'a' + 26);
+    if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0' + 52);
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+bool decodeVLQ(const char *&p, const char *end, int32_t *out) {
+    uint32_t result = 0;
+    uint32_t shift  = 0;
+    while (p < end) {
+        int8_t digit = base64Digit(*p++);
+        if (digit < 0 || shift > 28) {
+            return false;
+        }
+        result |= static_cast<uint32_t>(digit & 0x1F) << shift;
+        if ((digit & 0x20) == 0) {
+            auto value = static_cast<int32_t>(result >> 1U);
+            *out       = (result & 1U) != 0 ? -value : value;
+            return true;
+        }
+        shift += 5;
+    }
+    return false;
+}
+
+bool readStringArray(v8::Isolate *isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> obj, const char *key, std::vector<std::string> *out) {
+    v8::Local<v8::Value> val;
+    if (!obj->Get(context, v8::String::NewFromUtf8(isolate, key).ToLocalChecked()).ToLocal(&val) || !val->IsArray()) {
+        return false;
+    }
+    v8::Local<v8::Array> arr = val.As<v8::Array>();
+    out->resize(arr->Length());
+    for (uint32_t i = 0; i < arr->Length(); ++i) {
+        v8::Local<v8::Value> element;
+        if (arr->Get(context, i).ToLocal(&element) && element->IsString()) {
+            (*out)[i] = *v8::String::Utf8Value(isolate, element);
+        }
+    }
+    return true;
+}
+
+class IndexWriter {
+public:
+    void writeUint32(uint32_t value) { _data.append(reinterpret_cast<const char *>(&value), sizeof(value)); }
+    void writeString(const std::string &str) {
+        writeUint32(static_cast<uint32_t>(str.length()));
+        _data.append(str);
+    }
+    void writeBytes(const void *data, size_t size) { _data.append(static_cast<const char *>(data), size); }
+
+    std::string &data() { return _data; }
+
+private:
+    std::string _data;
+};
+
+class IndexReader {
+public:
+    IndexReader(const uint8_t *data, size_t size) : _p(data), _end(data + size) {}
+
+    bool readUint32(uint32_t *value) { return readBytes(value, sizeof(*value)); }
+    bool readString(std::string *str) {
+        uint32_t length = 0;
+        if (!readUint32(&length) || static_cast<size_t>(_end - _p) < length) {
+            return false;
+        }
+        str->assign(reinterpret_cast<const char *>(_p), length);
+        _p += length;
+        return true;
+    }
+    bool readBytes(void *data, size_t size) {
+        if (static_cast<size_t>(_end - _p) < size) {
+            return false;
+        }
+        memcpy(data, _p, size);
+        _p += size;
+        return true;
+    }
+
+private:
+    const uint8_t *_p;
+    const uint8_t *_end;
+};
+} // namespace
+
+bool SourceMap::parse(const char *json, size_t length) {
+    v8::Isolate *          isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope        hs(isolate);
+    v8::TryCatch           tryCatch(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    v8::Local<v8::String> jsonStr;
+    v8::Local<v8::Value>  root;
+    if (!v8::String::NewFromUtf8(isolate, json, v8::NewStringType::kNormal, static_cast<int>(length)).ToLocal(&jsonStr) ||
+        !v8::JSON::Parse(context, jsonStr).ToLocal(&root) || !root->IsObject()) {
+        SE_LOGE("SourceMap::parse, invalid JSON\n");
+        return false;
+    }
+
+    v8::Local<v8::Object> obj = root.As<v8::Object>();
+    v8::Local<v8::Value>  mappings;
+    if (!readStringArray(isolate, context, obj, "sources", &_sources) ||
+        !obj->Get(context, v8::String::NewFromUtf8Literal(isolate, "mappings")).ToLocal(&mappings) || !mappings->IsString()) {
+        SE_LOGE("SourceMap::parse, \"sources\" or \"mappings\" is missing, index map isn't supported\n");
+        return false;
+    }
+    readStringArray(isolate, context, obj, "names", &_names);
+
+    v8::Local<v8::Value> sourceRoot;
+    if (obj->Get(context, v8::String::NewFromUtf8Literal(isolate, "sourceRoot")).ToLocal(&sourceRoot) && sourceRoot->IsString()) {
+        std::string root = *v8::String::Utf8Value(isolate, sourceRoot);
+        if (!root.empty()) {
+            if (root.back() != '/') {
+                root += '/';
+            }
+            for (auto &source : _sources) {
+                source.insert(0, root);
+            }
+        }
+    }
+
+    v8::String::Utf8Value mappingsStr(isolate, mappings);
+    return decodeMappings(*mappingsStr, mappingsStr.length());
+}
+
+bool SourceMap::decodeMappings(const char *mappings, size_t length) {
+    _lineOffsets.clear();
+    _segments.clear();
+    _segments.reserve(length / 4);
+    _lineOffsets.push_back(0);
+
+    // All fields except the generated column are relative to the previous segment, regardless of the line.
+    int32_t     source         = 0;
+    int32_t     originalLine   = 0;
+    int32_t     originalColumn = 0;
+    int32_t     name           = 0;
+    int32_t     column         = 0;
+    const char *p              = mappings;
+    const char *end            = mappings + length;
+    while (p < end) {
+        if (*p == ';') {
+            auto lineBegin = _segments.begin() + _lineOffsets.back();
+            std::stable_sort(lineBegin, _segments.end(), [](const Segment &a, const Segment &b) { return a.column < b.column; });
+            _lineOffsets.push_back(static_cast<uint32_t>(_segments.size()));
+            column = 0;
+            ++p;
+            continue;
+        }
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+
+        int32_t fields[5] = {0};
+        int     count     = 0;
+        while (p < end && *p != ',' && *p != ';') {
+            if (count >= 5 || !decodeVLQ(p, end, &fields[count])) {
+                SE_LOGE("SourceMap::decodeMappings, invalid VLQ at %d\n", static_cast<int>(p - mappings));
+                return false;
+            }
+            ++count;
+        }
+
+        column += fields[0];
+        if (count < 4) {
+            continue; // Segment without source isn't useful for lookup.
+        }
+        source += fields[1];
+        originalLine += fields[2];
+        originalColumn += fields[3];
+        uint32_t nameIndex = NO_NAME;
+        if (count == 5) {
+            name += fields[4];
+            nameIndex = static_cast<uint32_t>(name);
+        }
+        if (column < 0 || source < 0 || originalLine < 0 || originalColumn < 0) {
+            return false;
+        }
+        _segments.push_back({static_cast<uint32_t>(column), static_cast<uint32_t>(source), static_cast<uint32_t>(originalLine), static_cast<uint32_t>(originalColumn), nameIndex});
+    }
+
+    auto lineBegin = _segments.begin() + _lineOffsets.back();
+    std::stable_sort(lineBegin, _segments.end(), [](const Segment &a, const Segment &b) { return a.column < b.column; });
+    _lineOffsets.push_back(static_cast<uint32_t>(_segments.size()));
+    _segments.shrink_to_fit();
+    return true;
+}
+
+bool SourceMap::loadIndex(const uint8_t *data, size_t size, const std::string &fingerprint) {
+    IndexReader reader(data, size);
+    uint32_t    magic   = 0;
+    uint32_t    version = 0;
+    std::string savedFingerprint;
+    if (!reader.readUint32(&magic) || magic != INDEX_MAGIC || !reader.readUint32(&version) || version != INDEX_VERSION ||
+        !reader.readString(&savedFingerprint) || savedFingerprint != fingerprint) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    if (!reader.readUint32(&count)) {
+        return false;
+    }
+    _sources.resize(count);
+    for (auto &source : _sources) {
+        if (!reader.readString(&source)) {
+            return false;
+        }
+    }
+    if (!reader.readUint32(&count)) {
+        return false;
+    }
+    _names.resize(count);
+    for (auto &name : _names) {
+        if (!reader.readString(&name)) {
+            return false;
+        }
+    }
+    if (!reader.readUint32(&count) || count > size / sizeof(uint32_t)) {
+        return false;
+    }
+    _lineOffsets.resize(count);
+    if (!reader.readBytes(_lineOffsets.data(), count * sizeof(uint32_t)) || !reader.readUint32(&count) || count > size / sizeof(Segment)) {
+        return false;
+    }
+    _segments.resize(count);
+    if (!reader.readBytes(_segments.data(), count * sizeof(Segment))) {
+        return false;
+    }
+
+    // lookup indexes _segments with these offsets directly, a corrupted cache must not be trusted.
+    bool isValid = !_lineOffsets.empty() && _lineOffsets.front() == 0 && _lineOffsets.back() == _segments.size();
+    for (size_t i = 1; isValid && i < _lineOffsets.size(); ++i) {
+        isValid = _lineOffsets[i - 1] <= _lineOffsets[i];
+    }
+    if (!isValid) {
+        SE_LOGE("SourceMap::loadIndex, invalid line offsets\n");
+        _sources.clear();
+        _names.clear();
+        _lineOffsets.clear();
+        _segments.clear();
+    }
+    return isValid;
+}
+
+std::string SourceMap::saveIndex(const std::string &fingerprint) const {
+    IndexWriter writer;
+    writer.writeUint32(INDEX_MAGIC);
+    writer.writeUint32(INDEX_VERSION);
+    writer.writeString(fingerprint);
+    writer.writeUint32(static_cast<uint32_t>(_sources.size()));
+    for (const auto &source : _sources) {
+        writer.writeString(source);
+    }
+    writer.writeUint32(static_cast<uint32_t>(_names.size()));
+    for (const auto &name : _names) {
+        writer.writeString(name);
+    }
+    writer.writeUint32(static_cast<uint32_t>(_lineOffsets.size()));
+    writer.writeBytes(_lineOffsets.data(), _lineOffsets.size() * sizeof(uint32_t));
+    writer.writeUint32(static_cast<uint32_t>(_segments.size()));
+    writer.writeBytes(_segments.data(), _segments.size() * sizeof(Segment));
+    return std::move(writer.data());
+}
+
+bool SourceMap::lookup(uint32_t line, uint32_t column, std::string *source, uint32_t *originalLine, uint32_t *originalColumn, std::string *name) const {
+    if (line + 1 >= _lineOffsets.size()) {
+        return false;
+    }
+
+    auto begin = _segments.begin() + _lineOffsets[line];
+    auto end   = _segments.begin() + _lineOffsets[line + 1];
+    // The last segment which starts at or before the column.
+    auto iter = std::upper_bound(begin, end, column, [](uint32_t col, const Segment &segment) { return col < segment.column; });
+    if (iter == begin) {
+        return false;
+    }
+    const Segment &segment = *(iter - 1);
+    if (segment.source >= _sources.size()) {
+        return false;
+    }
+
+    *source         = _sources[segment.source];
+    *originalLine   = segment.originalLine;
+    *originalColumn = segment.originalColumn;
+    if (name != nullptr) {
+        *name = segment.name < _names.size() ? _names[segment.name] : "";
+    }
+    return true;
+}
+
+} // namespace se
+
+#endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
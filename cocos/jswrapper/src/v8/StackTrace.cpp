@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+ Copyright (c) 2017-2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "StackTrace.h"
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+
+namespace se {
+
+StackTrace StackTrace::capture(uint32_t frameLimit, Detail detail) {
+    v8::Isolate *isolate = v8::Isolate::GetCurrent();
+    if (isolate == nullptr || frameLimit == 0 || !isolate->InContext()) {
+        return StackTrace();
+    }
+
+    v8::HandleScope hs(isolate);
+    return StackTrace(v8::StackTrace::CurrentStackTrace(isolate, static_cast<int>(frameLimit), detail == Detail::DETAILED ? v8::StackTrace::kDetailed : v8::StackTrace::kOverview));
+}
+
+StackTrace::StackTrace(v8::Local<v8::StackTrace> stack) {
+    if (!stack.IsEmpty()) {
+        _stack.Reset(v8::Isolate::GetCurrent(), stack);
+    }
+}
+
+StackTrace::StackTrace(StackTrace &&other) noexcept
+: _stack(std::move(other._stack)),
+  _cachedString(std::move(other._cachedString)),
+  _isSymbolized(other._isSymbolized) {
+    other._isSymbolized = false;
+}
+
+StackTrace &StackTrace::operator=(StackTrace &&other) noexcept {
+    if (this != &other) {
+        _stack              = std::move(other._stack);
+        _cachedString       = std::move(other._cachedString);
+        _isSymbolized       = other._isSymbolized;
+        other._isSymbolized = false;
+    }
+    return *this;
+}
+
+uint32_t StackTrace::getFrameCount() const {
+    if (_stack.IsEmpty()) {
+        return 0;
+    }
+    v8::Isolate *   isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope hs(isolate);
+    return static_cast<uint32_t>(_stack.Get(isolate)->GetFrameCount());
+}
+
+bool StackTrace::getFrame(uint32_t index, Frame *frame) const {
+    assert(frame != nullptr);
+    if (_stack.IsEmpty()) {
+        return false;
+    }
+
+    v8::Isolate *             isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope           hs(isolate);
+    v8::Local<v8::StackTrace> stack = _stack.Get(isolate);
+    if (index >= static_cast<uint32_t>(stack->GetFrameCount())) {
+        return false;
+    }
+
+    v8::Local<v8::StackFrame> stackFrame = stack->GetFrame(isolate, index);
+    v8::Local<v8::String>     func       = stackFrame->GetFunctionName();
+    frame->functionName                  = func.IsEmpty() ? "" : *v8::String::Utf8Value(isolate, func);
+    v8::Local<v8::String> script         = stackFrame->GetScriptName();
+    frame->scriptName                    = script.IsEmpty() ? "" : *v8::String::Utf8Value(isolate, script);
+    frame->scriptId                      = stackFrame->GetScriptId();
+    frame->line                          = stackFrame->GetLineNumber();
+    frame->column                        = stackFrame->GetColumn();
+    return true;
+}
+
+const std::string &StackTrace::toString() const {
+    if (_isSymbolized) {
+        return _cachedString;
+    }
+    _isSymbolized = true;
+    _cachedString.clear();
+
+    Frame    frame;
+    uint32_t frameCount = getFrameCount();
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        if (!getFrame(i, &frame)) {
+            break;
+        }
+        _cachedString += " - [";
+        _cachedString += std::to_string(i);
+        _cachedString += "]";
+        _cachedString += frame.functionName.empty() ? "anonymous" : frame.functionName;
+        _cachedString += "@";
+        _cachedString += frame.scriptName.empty() ? "(no filename)" : frame.scriptName;
+        _cachedString += ":";
+        _cachedString += std::to_string(frame.line);
+        if (i < (frameCount - 1)) {
+            _cachedString += "\n";
+        }
+    }
+    return _cachedString;
+}
+
+void StackTrace::reset() {
+    _stack.Reset();
+    _cachedString.clear();
+    _isSymbolized = false;
+}
+
+v8::Local<v8::StackTrace> StackTrace::_getStackTrace() const { // NOLINT(readability-identifier-naming)
+    return _stack.Get(v8::Isolate::GetCurrent());
+}
+
+} // namespace se
+
+#endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
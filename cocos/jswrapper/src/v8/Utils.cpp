@@ -36,14 +36,14 @@ namespace se {
 
 namespace internal {
 
-void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &v8args, ValueArray &outArr) {
+void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &v8args, Value *outArr) {
     v8::Isolate *isolate = v8args.GetIsolate();
     for (int i = 0; i < v8args.Length(); i++) {
         jsToSeValue(isolate, v8args[i], &outArr[i]);
     }
 }
 
-void seToJsArgs(v8::Isolate *isolate, const ValueArray &args, v8::Local<v8::Value> *outArr) {
+void seToJsArgs(v8::Isolate *isolate, ValueSpan args, v8::Local<v8::Value> *outArr) {
     assert(outArr != nullptr);
     uint32_t i = 0;
     for (const auto &data : args) {
@@ -88,6 +88,13 @@ void seToJsValue(v8::Isolate *isolate, const Value &v, v8::Local<v8::Value> *out
     }
 }
 
+v8::Local<v8::Value> nativeToJsValue(v8::Isolate *isolate, Object *obj) {
+    if (obj == nullptr) {
+        return v8::Null(isolate);
+    }
+    return obj->_getJSObject();
+}
+
 void jsToSeValue(v8::Isolate *isolate, v8::Local<v8::Value> jsval, Value *v) {
     assert(v != nullptr);
     v8::HandleScope handleScope(isolate);
@@ -19,16 +19,15 @@ static bool js_war_Tank_fire(se::State& s) // NOLINT(readability-identifier-nami
 {
     auto* cobj = SE_THIS_OBJECT<war::Tank>(s);
     SE_PRECONDITION2(cobj, false, "js_war_Tank_fire : Invalid Native Object");
-    const auto& args = s.args();
-    size_t argc = args.size();
+    size_t argc = s.argCount();
     CC_UNUSED bool ok = true;
     if (argc == 3) {
         HolderType<float, false> arg0 = {};
         HolderType<float, false> arg1 = {};
         HolderType<float, false> arg2 = {};
-        ok &= sevalue_to_native(args[0], &arg0, s.thisObject());
-        ok &= sevalue_to_native(args[1], &arg1, s.thisObject());
-        ok &= sevalue_to_native(args[2], &arg2, s.thisObject());
+        arg0.data = s.arg<float>(0);
+        arg1.data = s.arg<float>(1);
+        arg2.data = s.arg<float>(2);
         SE_PRECONDITION2(ok, false, "js_war_Tank_fire : Error processing arguments");
         cobj->fire(arg0.value(), arg1.value(), arg2.value());
         return true;
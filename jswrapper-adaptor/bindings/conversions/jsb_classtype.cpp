@@ -25,4 +25,5 @@
 
 #include "jsb_classtype.h"
 
-std::unordered_map<std::string, se::Class *> JSBClassType::jsbClassTypeMap;
+std::unordered_map<std::string, se::Class *>             JSBClassType::jsbClassTypeMap;
+std::unordered_map<std::string, se::Class::LazyInstallFunc> JSBClassType::jsbLazyClassMap;
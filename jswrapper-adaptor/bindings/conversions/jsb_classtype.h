@@ -38,14 +38,39 @@ public:
         jsbClassTypeMap.emplace(typeName, cls);
     }
 
+    /**
+     *  @brief Defines the class of T to be installed on first access, see `se::Class::defineLazy`.
+     *  @note The class is also installed when it's looked up by `findClass` or `installLazyClass`.
+     */
+    template <typename T>
+    static bool defineLazyClass(se::Object *ns, const char *name, se::Class::LazyInstallFunc installFunc) {
+        jsbLazyClassMap.emplace(typeid(T).name(), installFunc);
+        return se::Class::defineLazy(ns, name, installFunc);
+    }
+
+    /**
+     *  @brief Installs the class of T if it's defined by `defineLazyClass` and not installed yet.
+     *  @return true if the class of T is registered.
+     */
+    template <typename T>
+    static bool installLazyClass() {
+        const char *typeName = typeid(T).name();
+        if (jsbClassTypeMap.find(typeName) != jsbClassTypeMap.end()) {
+            return true;
+        }
+        auto iter = jsbLazyClassMap.find(typeName);
+        return iter != jsbLazyClassMap.end() && se::Class::installLazy(iter->second);
+    }
+
     template <typename T>
     static se::Class *findClass(const T * /*nativeObj*/) {
         bool        found    = false;
         std::string typeName = typeid(T).name();
         auto        iter     = jsbClassTypeMap.find(typeName);
         if (iter == jsbClassTypeMap.end()) {
-            typeName = typeid(T).name();
-            iter     = jsbClassTypeMap.find(typeName);
+            if (installLazyClass<T>()) {
+                iter = jsbClassTypeMap.find(typeName);
+            }
             if (iter != jsbClassTypeMap.end()) {
                 found = true;
             }
@@ -57,8 +82,10 @@ public:
 
     static void cleanup() {
         jsbClassTypeMap.clear();
+        jsbLazyClassMap.clear();
     }
 
 private:
-    static std::unordered_map<std::string, se::Class *> jsbClassTypeMap;
+    static std::unordered_map<std::string, se::Class *>             jsbClassTypeMap;
+    static std::unordered_map<std::string, se::Class::LazyInstallFunc> jsbLazyClassMap;
 };
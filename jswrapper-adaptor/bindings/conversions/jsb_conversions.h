@@ -469,6 +469,52 @@ bool native_ptr_to_seval(T *vp, se::Value *ret, bool *isReturnCachedValue = null
 
     return true;
 }
+// Probes the wrappers of all pointers first, then creates the missing ones in one loop and the array at once.
+template <typename T>
+bool native_ptr_array_to_seval(T *const *v, size_t count, se::Value *ret) { // NOLINT(readability-identifier-naming)
+    using DecayT = typename std::decay<typename std::remove_const<T>::type>::type;
+    assert(ret != nullptr);
+    se::AutoHandleScope hs;
+
+    std::vector<se::Object *> objects(count, nullptr);
+    std::vector<size_t>       missing;
+    for (size_t i = 0; i < count; ++i) {
+        auto *p = const_cast<DecayT *>(v[i]);
+        if (p == nullptr) {
+            continue;
+        }
+        auto iter = se::NativePtrToObjectMap::find(p);
+        if (iter != se::NativePtrToObjectMap::end()) {
+            objects[i] = iter->second;
+        } else {
+            missing.push_back(i);
+        }
+    }
+
+    if (!missing.empty()) {
+        se::Class *cls = JSBClassType::findClass(static_cast<const DecayT *>(nullptr));
+        assert(cls != nullptr);
+        for (auto i : missing) {
+            auto *p = const_cast<DecayT *>(v[i]);
+            // The same pointer may appear more than once.
+            auto iter = se::NativePtrToObjectMap::find(p);
+            if (iter != se::NativePtrToObjectMap::end()) {
+                objects[i] = iter->second;
+                continue;
+            }
+            // Same as native_ptr_to_seval, the reference of creation is released by the finalizer.
+            // The JavaScript objects are kept alive by the handle scope until they are stored in the array.
+            se::Object *obj = se::Object::createObjectWithClass(cls);
+            cc_tmp_set_private_data(obj, p);
+            objects[i] = obj;
+        }
+    }
+
+    se::HandleObject array(se::Object::createArrayObject(objects.data(), count));
+    ret->setObject(array, true);
+    return true;
+}
+
 template <typename T>
 bool std_vector_to_seval(const std::vector<T> &v, se::Value *ret) { // NOLINT(readability-identifier-naming)
     assert(ret != nullptr);
@@ -488,6 +534,12 @@ bool std_vector_to_seval(const std::vector<T> &v, se::Value *ret) { // NOLINT(re
     return ok;
 }
 
+template <typename T>
+inline typename std::enable_if<std::is_class<typename std::remove_cv<T>::type>::value, bool>::type
+std_vector_to_seval(const std::vector<T *> &v, se::Value *ret) { // NOLINT(readability-identifier-naming)
+    return native_ptr_array_to_seval(v.data(), v.size(), ret);
+}
+
 template <typename T>
 bool seval_to_reference(const se::Value &v, T **ret) { // NOLINT(readability-identifier-naming)
     assert(ret != nullptr);
@@ -674,6 +726,9 @@ bool sevalue_to_native(const se::Value &from, std::array<T, N> *to, se::Object *
 template <typename T>
 bool sevalue_to_native(const se::Value &from, cc::IntrusivePtr<T> *to, se::Object *ctx); // NOLINT(readability-identifier-naming)
 
+template <typename T>
+decltype(auto) nativevalue_to_invoke_arg(const T &from, se::Object *ctx); // NOLINT(readability-identifier-naming)
+
 //////////////////// std::array
 
 template <typename T, size_t CNT>
@@ -786,6 +841,36 @@ sevalue_to_native(const se::Value &from, T ***to, se::Object * /*ctx*/) { // NOL
     return true;
 }
 
+/**
+ * Elements of these types are converted by se::Object::getArrayElements without se::Value.
+ */
+template <typename T>
+struct is_direct_array_element // NOLINT(readability-identifier-naming)
+: std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                                   (std::is_pointer<T>::value && std::is_class<std::remove_cv_t<std::remove_pointer_t<T>>>::value)> {};
+
+template <typename T, typename allocator>
+inline typename std::enable_if<is_direct_array_element<T>::value, bool>::type
+se_array_to_std_vector(se::Object *array, std::vector<T, allocator> *to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
+    return array->getArrayElements(to);
+}
+
+template <typename T, typename allocator>
+inline typename std::enable_if<!is_direct_array_element<T>::value, bool>::type
+se_array_to_std_vector(se::Object *array, std::vector<T, allocator> *to, se::Object *ctx) { // NOLINT(readability-identifier-naming)
+    uint32_t len = 0;
+    array->getArrayLength(&len);
+    to->resize(len);
+    se::Value tmp;
+    for (uint32_t i = 0; i < len; i++) {
+        array->getArrayElement(i, &tmp);
+        if (!sevalue_to_native(tmp, to->data() + i, ctx)) {
+            SE_LOGE("vector %s convert error at %d\n", typeid(T).name(), i);
+        }
+    }
+    return true;
+}
+
 template <typename T, typename allocator>
 bool sevalue_to_native(const se::Value &from, std::vector<T, allocator> *to, se::Object *ctx) { // NOLINT(readability-identifier-naming)
 
@@ -798,17 +883,7 @@ bool sevalue_to_native(const se::Value &from, std::vector<T, allocator> *to, se:
     se::Object *array = from.toObject();
 
     if (array->isArray()) {
-        uint32_t len = 0;
-        array->getArrayLength(&len);
-        to->resize(len);
-        se::Value tmp;
-        for (uint32_t i = 0; i < len; i++) {
-            array->getArrayElement(i, &tmp);
-            if (!sevalue_to_native(tmp, to->data() + i, ctx)) {
-                SE_LOGE("vector %s convert error at %d\n", typeid(T).name(), i);
-            }
-        }
-        return true;
+        return se_array_to_std_vector(array, to, ctx);
     }
 
     if (array->isTypedArray()) {
@@ -833,13 +908,8 @@ inline bool sevalue_to_native(const se::Value &from, std::function<R(Args...)> *
         self->attachObject(callback);
         *func = [callback, self](Args... inargs) {
             se::AutoHandleScope hs;
-            bool                ok = true;
-            se::ValueArray      args;
-            int                 idx = 0;
-            args.resize(sizeof...(Args));
-            nativevalue_to_se_args_v(args, inargs...);
-            se::Value rval;
-            bool      succeed = callback->call(args, self, &rval);
+            se::Value           rval;
+            bool                succeed = callback->invoke(self, &rval, nativevalue_to_invoke_arg(inargs, nullptr)...);
             if (!succeed) {
                 se::ScriptEngine::getInstance()->clearException();
             }
@@ -1161,6 +1231,10 @@ bool nativevalue_to_se(const std::tuple<ARGS...> &from, se::Value &to, se::Objec
 template <typename T, typename A>
 inline bool nativevalue_to_se(const std::vector<T, A> &from, se::Value &to, se::Object *ctx); // NOLINT
 
+template <typename T, typename A>
+inline typename std::enable_if<std::is_class<typename std::remove_cv<T>::type>::value, bool>::type
+nativevalue_to_se(const std::vector<T *, A> &from, se::Value &to, se::Object *ctx); // NOLINT
+
 template <typename K, typename V>
 inline bool nativevalue_to_se(const std::unordered_map<K, V> &from, se::Value &to, se::Object *ctx); // NOLINT
 
@@ -1186,6 +1260,13 @@ inline bool nativevalue_to_se(const std::vector<T, A> &from, se::Value &to, se::
     return true;
 }
 
+// Vectors of native object pointers are wrapped in a batch.
+template <typename T, typename A>
+inline typename std::enable_if<std::is_class<typename std::remove_cv<T>::type>::value, bool>::type
+nativevalue_to_se(const std::vector<T *, A> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
+    return native_ptr_array_to_seval(from.data(), from.size(), &to);
+}
+
 template <typename A>
 inline bool nativevalue_to_se(const std::vector<bool, A> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT
     se::HandleObject array(se::Object::createArrayObject(from.size()));
@@ -1235,6 +1316,10 @@ inline bool nativevalue_to_se(const std::array<T, N> &from, se::Value &to, se::O
 template <size_t N>
 inline bool nativevalue_to_se(const std::array<uint8_t, N> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::UINT8, from.data(), N);
+    if (array == nullptr) {
+        to.setUndefined();
+        return false;
+    }
     to.setObject(array);
     array->decRef();
     return true;
@@ -1243,6 +1328,10 @@ inline bool nativevalue_to_se(const std::array<uint8_t, N> &from, se::Value &to,
 template <size_t N>
 inline bool nativevalue_to_se(const std::array<uint16_t, N> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::INT16, from.data(), N * sizeof(uint16_t));
+    if (array == nullptr) {
+        to.setUndefined();
+        return false;
+    }
     to.setObject(array);
     array->decRef();
     return true;
@@ -1251,6 +1340,10 @@ inline bool nativevalue_to_se(const std::array<uint16_t, N> &from, se::Value &to
 template <size_t N>
 inline bool nativevalue_to_se(const std::array<float, N> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::FLOAT32, from.data(), N * sizeof(float));
+    if (array == nullptr) {
+        to.setUndefined();
+        return false;
+    }
     to.setObject(array);
     array->decRef();
     return true;
@@ -1278,6 +1371,56 @@ bool nativevalue_to_se_args_v(se::ValueArray &array, Args &...args) { // NOLINT(
     return nativevalue_to_se_args<0, Args...>(array, args...);
 }
 
+///////////////////// invoke
+
+/**
+ * Arguments of these types are converted to JavaScript values directly by se::Object::invoke.
+ */
+template <typename T>
+struct is_direct_invoke_arg // NOLINT(readability-identifier-naming)
+: std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                                   std::is_same<T, std::string>::value || std::is_same<T, const char *>::value ||
+                                   std::is_same<T, char *>::value || std::is_same<T, std::nullptr_t>::value ||
+                                   std::is_same<T, se::Value>::value || std::is_same<T, se::Object *>::value> {};
+
+/**
+ * Forwards directly convertible arguments, other native types are converted by `nativevalue_to_se`.
+ */
+template <typename T>
+decltype(auto) nativevalue_to_invoke_arg(const T &from, se::Object *ctx) { // NOLINT(readability-identifier-naming)
+    if constexpr (is_direct_invoke_arg<std::decay_t<T>>::value) {
+        return (from);
+    } else {
+        se::Value ret;
+        nativevalue_to_se(from, ret, ctx);
+        return ret;
+    }
+}
+
+/**
+ * Calls a JavaScript function with native arguments and converts the result to R.
+ */
+template <typename R, typename... Args>
+inline bool invoke_js_function(se::Object *func, se::Object *thisObject, R *ret, const Args &...args) { // NOLINT(readability-identifier-naming)
+    se::Value rval;
+    if (!func->invoke(thisObject, &rval, nativevalue_to_invoke_arg(args, thisObject)...)) {
+        return false;
+    }
+    return sevalue_to_native(rval, ret, thisObject);
+}
+
+/**
+ * Calls `target[funcName]` with native arguments and converts the result to R.
+ */
+template <typename R, typename... Args>
+inline bool invoke_js_method(se::Object *target, const char *funcName, R *ret, const Args &...args) { // NOLINT(readability-identifier-naming)
+    se::Value rval;
+    if (!se::ScriptEngine::getInstance()->invokeFunction(target, funcName, &rval, nativevalue_to_invoke_arg(args, target)...)) {
+        return false;
+    }
+    return sevalue_to_native(rval, ret, target);
+}
+
 // Spine conversions
 #if USE_SPINE
 
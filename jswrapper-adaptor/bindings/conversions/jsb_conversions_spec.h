@@ -178,6 +178,10 @@ bool sevalue_to_native(const se::Value &from, std::vector<unsigned char> *to, se
 
 inline bool nativevalue_to_se(const std::vector<int8_t> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::INT8, from.data(), from.size());
+    if (array == nullptr) {
+        to.setUndefined();
+        return false;
+    }
     to.setObject(array);
     array->decRef();
     return true;
@@ -185,6 +189,10 @@ inline bool nativevalue_to_se(const std::vector<int8_t> &from, se::Value &to, se
 
 inline bool nativevalue_to_se(const std::vector<uint8_t> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::UINT8, from.data(), from.size());
+    if (array == nullptr) {
+        to.setUndefined();
+        return false;
+    }
     to.setObject(array);
     array->decRef();
     return true;
@@ -29,8 +29,10 @@
 #include "uv.h"
 
 #include <chrono>
+#include <mutex>
 #include <regex>
 #include <sstream>
+#include <unordered_set>
 #include "FileUtils.h"
 
 using namespace cc; //NOLINT
@@ -40,6 +42,15 @@ namespace {
 se::Object *                               __jsbObj = nullptr; //NOLINT
 se::Object *                               __glObj  = nullptr; //NOLINT
 std::unordered_map<std::string, se::Value> gModuleCache;
+std::unordered_map<std::string, JsbAsyncTaskFunc> gAsyncTasks;
+
+// Shared with the worker threads of jsb.runAsync, engine is cleared before the engine is cleaned up so results of stale tasks are dropped.
+struct AsyncTaskHost {
+    std::mutex        mutex;
+    se::ScriptEngine *engine{nullptr};
+};
+std::shared_ptr<AsyncTaskHost>   gAsyncTaskHost;
+std::unordered_set<se::Object *> gPendingResolvers; // Rooted until settled or the engine is cleaned up.
 
 static bool require(se::State &s) { //NOLINT
     const auto &args = s.args();
@@ -380,6 +391,97 @@ bool jsb_enable_debugger(const std::string &debuggerServerAddr, uint32_t port, b
     return true;
 }
 
+void jsb_register_async_task(const std::string &taskName, const JsbAsyncTaskFunc &func) { //NOLINT
+    gAsyncTasks[taskName] = func;
+}
+
+namespace {
+
+bool convertAsyncTaskInput(const se::Value &value, std::vector<uint8_t> *input) {
+    if (value.isNullOrUndefined()) {
+        return true;
+    }
+    if (value.isObject()) {
+        se::Object *obj    = value.toObject();
+        uint8_t *   data   = nullptr;
+        size_t      length = 0;
+        if ((obj->isArrayBuffer() && obj->getArrayBufferData(&data, &length)) || (obj->isTypedArray() && obj->getTypedArrayData(&data, &length))) {
+            input->assign(data, data + length);
+            return true;
+        }
+        std::string json;
+        if (!obj->toJSON(&json)) {
+            return false;
+        }
+        input->assign(json.begin(), json.end());
+        return true;
+    }
+    std::string str = value.toStringForce();
+    input->assign(str.begin(), str.end());
+    return true;
+}
+
+bool js_runAsync(se::State &s) { //NOLINT(readability-identifier-naming)
+    const auto &args = s.args();
+    if (args.empty() || !args[0].isString()) {
+        SE_REPORT_ERROR("jsb.runAsync: task name should be a string");
+        return false;
+    }
+    auto iter = gAsyncTasks.find(args[0].toString());
+    if (iter == gAsyncTasks.end()) {
+        SE_REPORT_ERROR("jsb.runAsync: task %s isn't registered", args[0].toString().c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> input;
+    if (args.size() > 1 && !convertAsyncTaskInput(args[1], &input)) {
+        SE_REPORT_ERROR("jsb.runAsync: input of %s can't be converted", args[0].toString().c_str());
+        return false;
+    }
+
+    se::Object *resolver = se::Object::createPromiseResolver(&s.rval());
+    if (resolver == nullptr) {
+        SE_REPORT_ERROR("jsb.runAsync: failed to create promise");
+        return false;
+    }
+    resolver->root();
+    gPendingResolvers.insert(resolver);
+
+    auto *   engine = se::ScriptEngine::getInstance();
+    uint32_t vmId   = engine->getVMId();
+    engine->postBackgroundTask([host = gAsyncTaskHost, func = iter->second, input = std::move(input), resolver, vmId]() {
+        auto        output = std::make_shared<std::vector<uint8_t>>();
+        std::string error;
+        bool        ok = func(input, output.get(), &error);
+
+        // The engine isn't looked up from this thread, it may have been destroyed.
+        std::lock_guard<std::mutex> lock(host->mutex);
+        if (host->engine == nullptr) {
+            return; // The engine is cleaned up, the resolver has been released.
+        }
+        se::ScriptEngine *engine = host->engine;
+        engine->postTask([engine, ok, output, error = std::move(error), resolver, vmId]() {
+            // Tasks posted while the engine was being cleaned up may run after it's restarted.
+            if (engine->getVMId() != vmId || gPendingResolvers.erase(resolver) == 0) {
+                return; // The resolver has been released by the cleanup hook.
+            }
+            se::AutoHandleScope hs;
+            se::HandleObject    buffer(ok ? se::Object::createArrayBufferObject(output->data(), output->size()) : nullptr);
+            if (buffer.get() != nullptr) {
+                resolver->resolvePromise(se::Value(buffer));
+            } else {
+                resolver->rejectPromise(se::Value(ok ? std::string("Failed to allocate the result") : error));
+            }
+            resolver->unroot();
+            resolver->decRef();
+        });
+    });
+    return true;
+}
+SE_BIND_FUNC(js_runAsync)
+
+} // namespace
+
 bool jsb_register_global_variables(se::Object *global) { //NOLINT
 
     global->defineFunction("require", _SE(require));
@@ -391,6 +493,7 @@ bool jsb_register_global_variables(se::Object *global) { //NOLINT
     glContextCls->install();
 
     __jsbObj->defineFunction("garbageCollect", _SE(jsc_garbageCollect));
+    __jsbObj->defineFunction("runAsync", _SE(js_runAsync));
 
     se::HandleObject performanceObj(se::Object::createPlainObject());
     performanceObj->defineFunction("now", _SE(js_performance_now));
@@ -398,6 +501,27 @@ bool jsb_register_global_variables(se::Object *global) { //NOLINT
 
     se::ScriptEngine::getInstance()->clearException();
 
+    se::ScriptEngine::getInstance()->addMemoryPressureHook([](se::ScriptEngine::MemoryPressureLevel /*level*/) {
+        FileUtils::getInstance()->purgeCachedEntries();
+        // gModuleCache is kept, `require` would evaluate the modules again without it.
+    });
+
+    gAsyncTaskHost         = std::make_shared<AsyncTaskHost>();
+    gAsyncTaskHost->engine = se::ScriptEngine::getInstance();
+    se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
+        {
+            std::lock_guard<std::mutex> lock(gAsyncTaskHost->mutex);
+            gAsyncTaskHost->engine = nullptr;
+        }
+        gAsyncTaskHost.reset();
+        // Pending promises are never settled, their resolvers would leak since Object::cleanup only resets the handles.
+        for (se::Object *resolver : gPendingResolvers) {
+            resolver->unroot();
+            resolver->decRef();
+        }
+        gPendingResolvers.clear();
+    });
+
     se::ScriptEngine::getInstance()->addAfterCleanupHook([]() {
         gModuleCache.clear();
 
@@ -24,8 +24,10 @@
 ****************************************************************************/
 
 #pragma once
+#include <functional>
 #include <string>
 #include <type_traits>
+#include <vector>
 #include "base/Ptr.h"
 #include "jswrapper/PrivateObject.h"
 
@@ -69,4 +71,13 @@ class Value;
 bool jsb_run_script(const std::string &filePath, se::Value *rval /* = nullptr */);
 bool jsb_register_global_variables(se::Object *global);
 void jsb_init_file_operation_delegate();
-bool jsb_enable_debugger(const std::string &debuggerServerAddr, uint32_t port, bool isWaitForConnect);
\ No newline at end of file
+bool jsb_enable_debugger(const std::string &debuggerServerAddr, uint32_t port, bool isWaitForConnect);
+
+// input, output, error message; runs in a worker thread, returns false if it fails.
+using JsbAsyncTaskFunc = std::function<bool(const std::vector<uint8_t> &, std::vector<uint8_t> *, std::string *)>;
+/**
+ * Registers a native task which is run by `jsb.runAsync(taskName, input)` off the thread of script engine.
+ * The input is an ArrayBuffer, a typed array, a string or an object serialized in JSON. The returned promise is resolved with an ArrayBuffer of the output.
+ * Tasks should be registered in the thread of script engine.
+ */
+void jsb_register_async_task(const std::string &taskName, const JsbAsyncTaskFunc &func);
\ No newline at end of file
@@ -466,6 +466,28 @@ class NativeType(object):
     def is_const_array(self):
         return self.kind == cindex.TypeKind.CONSTANTARRAY
 
+    @property
+    def js_type_mask(self):
+        # type tags of JS values accepted by the argument, see se::ArgType
+        if self.name == "std::string" or (self.name == "char" and self.is_pointer):
+            return "se::ArgType::STRING"
+        if self.is_function:
+            return "se::ArgType::FUNCTION | se::ArgType::NULL_OR_UNDEFINED"
+        if (self.is_numeric or self.is_enum or self.name == "bool") and not self.is_pointer:
+            return "se::ArgType::NUMBER | se::ArgType::BOOLEAN"
+        if self.is_const_array or self.name.startswith("std::vector"):
+            return "se::ArgType::ARRAY | se::ArgType::NULL_OR_UNDEFINED"
+        if self.is_object and self.is_pointer:
+            return "se::ArgType::OBJECT | se::ArgType::NULL_OR_UNDEFINED"
+        return "se::ArgType::ANY"
+
+    @property
+    def js_instance_class(self):
+        # class of native objects accepted by a pointer argument, used to tell overloads apart by class
+        if self.is_object and self.is_pointer and not self.is_function and self.namespaced_class_name.count("*") == 1:
+            return self.namespaced_class_name[:-1]
+        return None
+
     @staticmethod
     def from_type(ntype, generator):
         if ntype.kind == cindex.TypeKind.POINTER:
@@ -793,6 +815,13 @@ class NativeField(object):
         else:
             self.pretty_name = self.name
 
+    @property
+    def is_plain_value(self):
+        # non-const arithmetic or bool field which can be accessed by pointer to member
+        return not self.is_static and not self.is_const_array and not self.cursor.is_bitfield() \
+            and not self.cursor.type.is_const_qualified() and not self.ntype.is_pointer \
+            and (self.ntype.is_numeric or self.ntype.name == "bool")
+
     def toJSON(self):
         return {
             "name": self.export_name,
@@ -1041,6 +1070,15 @@ class NativeOverloadedFunction(object):
         self.min_args = min(self.min_args, func.min_args)
         self.implementations.append(func)
 
+    @property
+    def dispatch_table(self):
+        # implementations grouped by accepted argument count, in declaration order
+        table = {}
+        for func in self.implementations:
+            for argc in range(func.min_args, len(func.arguments) + 1):
+                table.setdefault(argc, []).append(func)
+        return sorted(table.items())
+
     def generate_code(self, current_class=None, is_override=False, is_ctor=False):
         self.is_ctor = is_ctor
         self.current_class = current_class
@@ -1317,7 +1355,7 @@ class NativeClass(object):
         for m in self.static_methods_clean():
             m['impl'].generate_code(self)
         for m in self.public_fields:
-            if self.should_export_field(m.name):
+            if self.should_export_field(m.name) and not self.should_define_field_directly(m):
                 m.generate_code(self)
         # generate register section
         register = Template(file=os.path.join(self.generator.target, "templates", "register.c"),
@@ -1328,6 +1366,10 @@ class NativeClass(object):
     def should_export_field(self, field_name):
         return (self.is_struct and not self.generator.should_skip_field(self.class_name, field_name)) or self.generator.should_bind_field(self.class_name, field_name)
 
+    def should_define_field_directly(self, field):
+        # accessed by pointer to member, struct objects are created by their own constructor so the native type is exact
+        return self.is_struct and field.is_plain_value
+
     def generate_struct_constructor(self):
         stream = open(os.path.join(
             self.generator.target, "conversions.yaml"), "r")
@@ -1606,6 +1648,7 @@ class Generator(object):
         self.out_file = opts['out_file']
         self.script_type = opts['script_type']
         self.macro_judgement = opts['macro_judgement']
+        self.lazy_install = opts['lazy_install']
         self._hpp_headers = filter(lambda x: len(x) > 0, opts['hpp_headers']) if opts['hpp_headers'] is not None else None
         self.cpp_headers = filter(lambda x: len(x) > 0, opts['cpp_headers']) if opts['cpp_headers'] is not None else None
         self.win32_clang_flags = opts['win32_clang_flags']
@@ -1908,6 +1951,15 @@ class Generator(object):
                 return True
         return False
 
+    def should_install_lazily(self, nclass):
+        """
+        returns True if the class should be installed on first access instead of in register_all
+        """
+        if not self.lazy_install or not isinstance(nclass, NativeClass):
+            return False
+        # nested classes look up their outer classes, and extended classes read themselves back while installing
+        return len(nclass.nested_classes) == 0 and not self.in_listed_extend_classed(nclass.class_name)
+
     def in_listed_extend_classed(self, class_name):
         """
         returns True if the class is in the list of required classes that need to extend
@@ -2340,6 +2392,7 @@ def main():
                 'out_file': opts.out_file or config.get(s, 'prefix'),
                 'script_type': t,
                 'macro_judgement': config.get(s, 'macro_judgement') if config.has_option(s, 'macro_judgement') else None,
+                'lazy_install': config.getboolean(s, 'lazy_install') if config.has_option(s, 'lazy_install') else False,
                 'hpp_headers': config.get(s, 'hpp_headers', raw=False, vars=dict(userconfig.items('DEFAULT'))).split(' ') if config.has_option(s, 'hpp_headers') else None,
                 'cpp_headers': config.get(s, 'cpp_headers', raw=False, vars=dict(userconfig.items('DEFAULT'))).split(' ') if config.has_option(s, 'cpp_headers') else None,
                 'win32_clang_flags': (config.get(s, 'win32_clang_flags', raw=False, vars=dict(userconfig.items('DEFAULT'))) or "").split(" ") if config.has_option(s, 'win32_clang_flags') else None
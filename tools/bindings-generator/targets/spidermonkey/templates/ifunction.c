@@ -5,8 +5,7 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
     auto* cobj = SE_THIS_OBJECT<${namespaced_class_name}>(s);
     SE_PRECONDITION2(cobj, false, "${signature_name} : Invalid Native Object");
 #if len($arguments) >= $min_args
-    const auto& args = s.args();
-    size_t argc = args.size();
+    size_t argc = s.argCount();
     #set arg_count = len($arguments)
     #set arg_idx = $min_args
     #if $arg_count > 0 or $ret_type.name != "void"
@@ -26,10 +25,13 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
             #set $holder_prefix="HolderType<"+$arg_type+", false>"
             #end if
             #set holder_prefix_array += [$holder_prefix]
+            #if ($arg.is_numeric or $arg.is_enum or $arg.name == "bool") and not $arg.is_pointer
+            #set conv_txt = "arg" + str(count) + ".data = s.arg<" + $arg_type + ">(" + str(count) + ")"
+            #else
             #set conv_txt= $arg.to_native({"generator": $generator,\
                              "arg" : $arg, \
                              "arg_type": $arg_type, \
-                             "in_value": "args[" + str(count) + "]", \
+                             "in_value": "s.args()[" + str(count) + "]", \
                              "out_value":  "arg"+str(count) , \
                              "class_name": $class_name,\
                              "level": 2, \
@@ -37,6 +39,7 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
                              "is_static": False, \
                              "is_persistent": $is_persistent, \
                              "ntype": str($arg)})
+            #end if
             #set arg_conv_array += [$conv_txt]
         $holder_prefix arg${count} = {};
             #set $count = $count + 1
@@ -65,6 +68,11 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
             #else
         ${ret_type.get_whole_name($generator)} result = cobj->${func_name}($arg_list);
             #end if
+            #if ($ret_type.is_numeric or $ret_type.is_enum) and not $ret_type.is_pointer
+        s.returnNumber(result);
+            #elif $ret_type.name == "bool" and not $ret_type.is_pointer
+        s.returnBoolean(result);
+            #else
         ${ret_type.from_native({"generator": $generator,
                                     "in_value": "result",
                                     "out_value": "s.rval()",
@@ -72,10 +80,11 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
                                     "ntype": str($ret_type),
                                     "level": 2})};
         SE_PRECONDITION2(ok, false, "${signature_name} : Error processing arguments");
-            #if $generator.should_obtain_return_value($class_name, $func_name)
+                #if $generator.should_obtain_return_value($class_name, $func_name)
         s.rval().toObject()->getPrivateObject()->tryAllowDestroyInGC();
-            #end if
+                #end if
         SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+            #end if
         #else
         cobj->${func_name}($arg_list);
         #end if
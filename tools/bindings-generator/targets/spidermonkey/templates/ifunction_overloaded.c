@@ -5,82 +5,104 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
     CC_UNUSED bool ok = true;
     auto* cobj = SE_THIS_OBJECT<${namespaced_class_name}>(s);
     SE_PRECONDITION2( cobj, false, "${signature_name} : Invalid Native Object");
-    const auto& args = s.args();
-    size_t argc = args.size();
-#for func in $implementations
-#if len($func.arguments) >= $func.min_args
-    #set arg_count = len($func.arguments)
-    #set arg_idx = $func.min_args
-    #while $arg_idx <= $arg_count
-    #set arg_list = ""
-    #set arg_array = []
-    #set arg_conv_array = []
+    size_t argc = s.argCount();
+    CC_UNUSED const se::ArgTypeList argTypes = s.argTypes();
+    switch (argc) {
+#for $dispatch_argc, $candidates in $dispatch_table
+    case ${dispatch_argc}:
+    #for func in $candidates
     do {
-        #if $func.min_args >= 0
-        if (argc == $arg_idx) {
-            #set $count = 0
-            #while $count < $arg_idx
-                #set $arg = $func.arguments[$count]
-                #set $arg_type = $arg.to_string($generator, omit_const = True)
-                #if $arg.is_reference
-                #set $holder_prefix="HolderType<"+$arg_type+", true>"
-                #else
-                #set $holder_prefix="HolderType<"+$arg_type+", false>"
-                #end if
-                #set $arg_array += [ "arg"+str(count)+".value()"]
-            $holder_prefix arg${count} = {};
-                #set $count = $count + 1
-            #end while
-            #set $arg_list = ", ".join($arg_array)
-
-            #set $count = 0
-            #while $count < $arg_idx
-                #set $arg = $func.arguments[$count]
-                #set $arg_type = $arg.to_string($generator)
-            ${arg.to_native({"generator": $generator,
-                             "arg" : $arg,
-                             "arg_type": $arg_type,
-                             "in_value": "args[" + str(count) + "]",
-                             "out_value": "arg" + str(count),
-                             "class_name": $class_name,
-                             "level": 3,
-                             "context" : "s.thisObject()",
-                             "is_static": False,
-                             "is_persistent": $is_persistent,
-                             "ntype": str($arg)})};
-                #set $count = $count + 1
-            #if $arg_idx > 0 and arg_type != "bool"
-            if (!ok) { ok = true; break; }
+        #set $count = 0
+        #set $type_checks = []
+        #while $count < $dispatch_argc
+            #set $mask = $func.arguments[$count].js_type_mask
+            #if $mask != "se::ArgType::ANY"
+            #set $type_checks += ["!argTypes.match(" + str(count) + ", " + $mask + ")"]
+            #end if
+            #set $instance_class = $func.arguments[$count].js_instance_class
+            #if len($candidates) > 1 and $instance_class is not None
+            #set $type_checks += ["!s.argIsInstanceOf(" + str(count) + ", JSBClassType::findClass(static_cast<const " + $instance_class + " *>(nullptr)))"]
             #end if
-            #end while
+            #set $count = $count + 1
+        #end while
+        #if len($type_checks) > 0
+        #set $type_check = " || ".join($type_checks)
+        if ($type_check) { break; }
         #end if
+        #set $count = 0
+        #set $arg_array = []
+        #while $count < $dispatch_argc
+            #set $arg = $func.arguments[$count]
+            #set $arg_type = $arg.to_string($generator, omit_const = True)
+            #if $arg.is_reference
+            #set $holder_prefix="HolderType<"+$arg_type+", true>"
+            #else
+            #set $holder_prefix="HolderType<"+$arg_type+", false>"
+            #end if
+            #if $arg.is_rreference
+            #set $arg_array += [ "std::move(arg"+str(count)+".value())"]
+            #else
+            #set $arg_array += [ "arg"+str(count)+".value()"]
+            #end if
+        $holder_prefix arg${count} = {};
+            #set $count = $count + 1
+        #end while
+        #set $count = 0
+        #while $count < $dispatch_argc
+            #set $arg = $func.arguments[$count]
+            #set $arg_type = $arg.to_string($generator)
+            #if ($arg.is_numeric or $arg.is_enum or $arg.name == "bool") and not $arg.is_pointer
+        arg${count}.data = s.arg<${arg_type}>(${count});
+            #else
+        ${arg.to_native({"generator": $generator,
+                         "arg" : $arg,
+                         "arg_type": $arg_type,
+                         "in_value": "s.args()[" + str(count) + "]",
+                         "out_value": "arg" + str(count),
+                         "class_name": $class_name,
+                         "level": 2,
+                         "context" : "s.thisObject()",
+                         "is_static": False,
+                         "is_persistent": $is_persistent,
+                         "ntype": str($arg)})};
+        if (!ok) { ok = true; break; }
+            #end if
+            #set $count = $count + 1
+        #end while
+        #set $arg_list = ", ".join($arg_array)
         #if str($func.ret_type) != "void"
             #if $func.ret_type.is_enum
-            auto result = static_cast<$ret_type.enum_declare_type>(cobj->${func.func_name}($arg_list));
+        auto result = static_cast<$func.ret_type.enum_declare_type>(cobj->${func.func_name}($arg_list));
+            #else
+        ${func.ret_type.get_whole_name($generator)} result = cobj->${func.func_name}($arg_list);
+            #end if
+            #if ($func.ret_type.is_numeric or $func.ret_type.is_enum) and not $func.ret_type.is_pointer
+        s.returnNumber(result);
+            #elif $func.ret_type.name == "bool" and not $func.ret_type.is_pointer
+        s.returnBoolean(result);
             #else
-            ${func.ret_type.get_whole_name($generator)} result = cobj->${func.func_name}($arg_list);
+        ${func.ret_type.from_native({"generator": $generator,
+                                     "in_value": "result",
+                                     "out_value": "s.rval()",
+                                     "context" : "s.thisObject()",
+                                     "class_name": $func.ret_type.get_class_name($generator),
+                                     "ntype": str($func.ret_type),
+                                     "level": 2})};
+        SE_PRECONDITION2(ok, false, "${signature_name} : Error processing arguments");
+        SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
             #end if
-            ${func.ret_type.from_native({"generator": $generator,
-                                                      "in_value": "result",
-                                                      "out_value": "s.rval()",
-                                                      "context" : "s.thisObject()",
-                                                      "class_name": $func.ret_type.get_class_name($generator),
-                                                      "ntype": str($func.ret_type),
-                                                      "level": 2})};
-            SE_PRECONDITION2(ok, false, "${signature_name} : Error processing arguments");
-            SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
         #else
-            cobj->${func.func_name}($arg_list);
+        cobj->${func.func_name}($arg_list);
         #end if
-            return true;
-        }
-    } while(false);
-
-    #set $arg_idx = $arg_idx + 1
-    #end while
-#end if
+        return true;
+    } while (false);
+    #end for
+        break;
 #end for
-    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    default:
+        break;
+    }
+    SE_REPORT_ERROR("${signature_name} : wrong number or types of arguments: %d", (int)argc);
     return false;
 }
 #if $current_class is not None
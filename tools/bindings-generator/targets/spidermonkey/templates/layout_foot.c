@@ -17,8 +17,12 @@ bool register_all_${prefix}(se::Object* obj)    // NOLINT
 
 #for jsclass in $sorted_classes
     #if $in_listed_classes(jsclass.class_name)
+    #if $should_install_lazily(jsclass)
+    JSBClassType::defineLazyClass<${jsclass.namespaced_class_name}>(ns, "${jsclass.target_class_name}", js_register_${prefix}_${jsclass.nested_class_name});
+    #else
     js_register_${prefix}_${jsclass.nested_class_name}(ns);
     #end if
+    #end if
 #end for
     return true;
 }
@@ -41,6 +41,11 @@ SE_BIND_FUNC(js_${current_class.underlined_class_name}_${current_class.rename_de
 
 bool js_register_${generator.prefix}_${current_class.nested_class_name}(se::Object* obj) // NOLINT(readability-identifier-naming)
 {
+#if len($current_class.parents) > 0
+    if (__jsb_${current_class.parents[0].underlined_class_name}_proto == nullptr) {
+        JSBClassType::installLazyClass<${current_class.parents[0].namespaced_class_name}>();
+    }
+#end if
 #if has_constructor
     #if len($current_class.parents) > 0
     auto* cls = se::Class::create(${current_class.nested_class_array}, obj, __jsb_${current_class.parents[0].underlined_class_name}_proto, _SE(js_${generator.prefix}_${current_class.class_name}_constructor));
@@ -57,8 +62,12 @@ bool js_register_${generator.prefix}_${current_class.nested_class_name}(se::Obje
 
 #for m in public_fields
     #if  $current_class.should_export_field(m.name) and not m.is_static
+    #if $current_class.should_define_field_directly(m)
+    cls->defineField<${current_class.namespaced_class_name}, &${current_class.namespaced_class_name}::${m.name}>("${m.export_name}");
+    #else
     cls->defineProperty("${m.export_name}", _SE(${m.signature_name}_get_${m.name}), _SE(${m.signature_name}_set_${m.name}));
     #end if
+    #end if
 #end for
 #for m in $current_class.getter_setter
     #set tmp_getter = "nullptr" if m["getter"] is None else "_SE(" + m["getter"].signature_name + "_asGetter)"
@@ -2,8 +2,7 @@
 
 static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-naming)
 {
-    const auto& args = s.args();
-    size_t argc = args.size();
+    size_t argc = s.argCount();
 #if len($arguments) >= $min_args
     #set arg_count = len($arguments)
     #set arg_idx = $min_args
@@ -32,16 +31,20 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
         #while $count < $arg_idx
             #set $arg = $arguments[$count]
             #set $arg_type = $arg.to_string($generator)
+            #if ($arg.is_numeric or $arg.is_enum or $arg.name == "bool") and not $arg.is_pointer
+        arg${count}.data = s.arg<${arg_type}>(${count});
+            #else
         ${arg.to_native({"generator": $generator,
             "arg" : $arg,
             "arg_type": $arg_type,
-            "in_value": "args[" + str(count) + "]",
+            "in_value": "s.args()[" + str(count) + "]",
             "out_value": "arg" + str(count),
             "class_name": $class_name,
             "level": 2,
             "is_static": True,
             "is_persistent": $is_persistent,
             "ntype": str($arg)})};
+            #end if
             #set $count = $count + 1
         #end while
         #if $arg_idx > 0
@@ -67,6 +70,11 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
           #else
         ${ret_type.get_whole_name($generator)} result = ${namespaced_class_name}::${func_name}($arg_list);
           #end if
+          #if ($ret_type.is_numeric or $ret_type.is_enum) and not $ret_type.is_pointer
+        s.returnNumber(result);
+          #elif $ret_type.name == "bool" and not $ret_type.is_pointer
+        s.returnBoolean(result);
+          #else
         ${ret_type.from_native({"generator": $generator,
                                 "in_value": "result",
                                 "out_value": "s.rval()",
@@ -75,6 +83,7 @@ static bool ${signature_name}(se::State& s) // NOLINT(readability-identifier-nam
                                 "level": 1})};
         SE_PRECONDITION2(ok, false, "${signature_name} : Error processing arguments");
         SE_HOLD_RETURN_VALUE(result, s.thisObject(), s.rval());
+          #end if
         #end if
     #else
         ${namespaced_class_name}::${func_name}($arg_list);